@@ -14,15 +14,22 @@
 #include <nano/store/account.hpp>
 #include <nano/store/block.hpp>
 #include <nano/store/lmdb/lmdb.hpp>
+#include <nano/store/memory/memory.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
 #include <nano/store/versioning.hpp>
+#include <nano/test_common/make_store.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
 
 #include <gtest/gtest.h>
 
+#include <boost/property_tree/ptree.hpp>
+
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
+#include <thread>
+#include <tuple>
 #include <unordered_set>
 #include <vector>
 
@@ -103,6 +110,55 @@ TEST (block_store, sideband_serialization)
 	ASSERT_EQ (sideband1.timestamp, sideband2.timestamp);
 }
 
+TEST (block_store, sideband_serialization_compact)
+{
+	nano::block_sideband sideband1;
+	sideband1.successor = 4;
+	sideband1.height = 300;
+	sideband1.timestamp = 1700000000;
+	sideband1.details = nano::block_details{ nano::epoch::epoch_2, true, false, false };
+	sideband1.source_epoch = nano::epoch::epoch_1;
+	std::vector<uint8_t> vector;
+	{
+		nano::vectorstream stream1 (vector);
+		sideband1.serialize (stream1, nano::block_type::state);
+	}
+	ASSERT_EQ (sideband1.size (nano::block_type::state), vector.size ());
+	// 2 byte height and 5 byte timestamp instead of 8 bytes each
+	ASSERT_EQ (nano::block_sideband::size_v24 (nano::block_type::state) - 9, vector.size ());
+	ASSERT_LE (vector.size (), nano::block_sideband::max_size (nano::block_type::state));
+	nano::bufferstream stream2 (vector.data (), vector.size ());
+	nano::block_sideband sideband2;
+	ASSERT_FALSE (sideband2.deserialize (stream2, nano::block_type::state));
+	ASSERT_EQ (sideband1.successor, sideband2.successor);
+	ASSERT_EQ (sideband1.height, sideband2.height);
+	ASSERT_EQ (sideband1.timestamp, sideband2.timestamp);
+	ASSERT_EQ (sideband1.details, sideband2.details);
+	ASSERT_EQ (sideband1.source_epoch, sideband2.source_epoch);
+}
+
+TEST (block_store, sideband_serialization_compact_limits)
+{
+	nano::block_sideband sideband1;
+	sideband1.height = std::numeric_limits<uint64_t>::max ();
+	sideband1.timestamp = 0;
+	std::vector<uint8_t> vector;
+	{
+		nano::vectorstream stream1 (vector);
+		sideband1.serialize (stream1, nano::block_type::send);
+	}
+	ASSERT_EQ (nano::block_sideband::max_size (nano::block_type::send) - 9, vector.size ());
+	nano::bufferstream stream2 (vector.data (), vector.size ());
+	nano::block_sideband sideband2;
+	ASSERT_FALSE (sideband2.deserialize (stream2, nano::block_type::send));
+	ASSERT_EQ (sideband1.height, sideband2.height);
+	ASSERT_EQ (sideband1.timestamp, sideband2.timestamp);
+	// Truncated entries are rejected
+	nano::bufferstream stream3 (vector.data (), vector.size () - 1);
+	nano::block_sideband sideband3;
+	ASSERT_TRUE (sideband3.deserialize (stream3, nano::block_type::send));
+}
+
 TEST (block_store, add_item)
 {
 	nano::logger logger;
@@ -689,6 +745,157 @@ TEST (mdb_block_store, bad_path)
 	ASSERT_TRUE (false);
 }
 
+TEST (mdb_block_store, compact)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		GTEST_SKIP ();
+	}
+	nano::logger logger;
+	auto path = nano::unique_path () / "data.ldb";
+	nano::lmdb_config lmdb_config;
+	lmdb_config.compaction_interval = std::chrono::hours{ 1 };
+	nano::store::lmdb::component store (logger, path, nano::dev::constants, nano::txn_tracking_config{}, std::chrono::milliseconds (5000), lmdb_config);
+	ASSERT_FALSE (store.init_error ());
+
+	std::vector<nano::block_hash> hashes;
+	{
+		auto transaction = store.tx_begin_write ();
+		for (auto i = 0; i < 10000; ++i)
+		{
+			hashes.push_back (nano::test::random_hash ());
+			store.pruned.put (transaction, hashes.back ());
+		}
+	}
+	{
+		auto transaction = store.tx_begin_write ();
+		for (std::size_t i = 1000; i < hashes.size (); ++i)
+		{
+			store.pruned.del (transaction, hashes[i]);
+		}
+	}
+	auto size_before = std::filesystem::file_size (path);
+
+	ASSERT_TRUE (store.compact ());
+	ASSERT_LT (std::filesystem::file_size (path), size_before);
+
+	// Data is retained and the database remains writable
+	{
+		auto transaction = store.tx_begin_read ();
+		ASSERT_EQ (1000, store.pruned.count (transaction));
+		ASSERT_TRUE (store.pruned.exists (transaction, hashes[0]));
+		ASSERT_FALSE (store.pruned.exists (transaction, hashes[1000]));
+	}
+	{
+		auto transaction = store.tx_begin_write ();
+		store.pruned.put (transaction, hashes[1000]);
+	}
+	ASSERT_TRUE (store.pruned.exists (store.tx_begin_read (), hashes[1000]));
+}
+
+// Transactions are not tracked without a compaction interval, compaction is refused
+TEST (mdb_block_store, compact_disabled)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		GTEST_SKIP ();
+	}
+	nano::logger logger;
+	auto path = nano::unique_path () / "data.ldb";
+	nano::store::lmdb::component store (logger, path, nano::dev::constants);
+	ASSERT_FALSE (store.init_error ());
+	ASSERT_FALSE (store.env.gate_enabled ());
+	ASSERT_FALSE (store.compact ());
+	ASSERT_FALSE (std::filesystem::exists (path.parent_path () / "compacting.ldb"));
+}
+
+// Read transactions keep their snapshot in the previous environment until renewed
+TEST (mdb_block_store, compact_open_read_transaction)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		GTEST_SKIP ();
+	}
+	nano::logger logger;
+	auto path = nano::unique_path () / "data.ldb";
+	nano::lmdb_config lmdb_config;
+	lmdb_config.compaction_interval = std::chrono::hours{ 1 };
+	nano::store::lmdb::component store (logger, path, nano::dev::constants, nano::txn_tracking_config{}, std::chrono::milliseconds (5000), lmdb_config);
+	ASSERT_FALSE (store.init_error ());
+
+	auto hash1 = nano::test::random_hash ();
+	auto hash2 = nano::test::random_hash ();
+	store.pruned.put (store.tx_begin_write (), hash1);
+	{
+		auto transaction = store.tx_begin_read ();
+		ASSERT_TRUE (store.compact ());
+		ASSERT_FALSE (std::filesystem::exists (path.parent_path () / "compacting.ldb"));
+		store.pruned.put (store.tx_begin_write (), hash2);
+		ASSERT_TRUE (store.pruned.exists (transaction, hash1));
+		ASSERT_FALSE (store.pruned.exists (transaction, hash2));
+
+		transaction.refresh ();
+		ASSERT_TRUE (store.pruned.exists (transaction, hash1));
+		ASSERT_TRUE (store.pruned.exists (transaction, hash2));
+	}
+	// The previous environment is closed along with its lock file once no reader uses it
+	ASSERT_FALSE (std::filesystem::exists (path.parent_path () / "retired0.ldb-lock"));
+}
+
+// Writes made while the copy is taken are replayed into the compacted database
+TEST (mdb_block_store, compact_concurrent_writes)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Don't test this in rocksdb mode
+		GTEST_SKIP ();
+	}
+	nano::test::system system;
+	nano::logger logger;
+	auto path = nano::unique_path () / "data.ldb";
+	nano::lmdb_config lmdb_config;
+	lmdb_config.compaction_interval = std::chrono::hours{ 1 };
+	nano::store::lmdb::component store (logger, path, nano::dev::constants, nano::txn_tracking_config{}, std::chrono::milliseconds (5000), lmdb_config);
+	ASSERT_FALSE (store.init_error ());
+	{
+		auto transaction = store.tx_begin_write ();
+		for (auto i = 0; i < 10000; ++i)
+		{
+			store.pruned.put (transaction, nano::test::random_hash ());
+		}
+	}
+
+	std::atomic<bool> stopped{ false };
+	std::atomic<std::size_t> written{ 0 };
+	std::vector<nano::block_hash> hashes;
+	std::thread writer ([&] () {
+		while (!stopped)
+		{
+			auto hash = nano::test::random_hash ();
+			store.pruned.put (store.tx_begin_write (), hash);
+			hashes.push_back (hash);
+			++written;
+		}
+	});
+	ASSERT_TIMELY (5s, written > 0);
+	ASSERT_TRUE (store.compact ());
+	// Writes resume after the swap
+	auto const written_compacted = written.load ();
+	ASSERT_TIMELY (5s, written > written_compacted);
+	stopped = true;
+	writer.join ();
+
+	auto transaction = store.tx_begin_read ();
+	ASSERT_EQ (10000 + hashes.size (), store.pruned.count (transaction));
+	for (auto const & hash : hashes)
+	{
+		ASSERT_TRUE (store.pruned.exists (transaction, hash));
+	}
+}
+
 TEST (block_store, DISABLED_already_open) // File can be shared
 {
 	auto path (nano::unique_path ());
@@ -1431,6 +1638,132 @@ TEST (mdb_block_store, upgrade_v23_v24)
 	// Testing the upgrade code worked
 	check_correct_state ();
 }
+
+TEST (mdb_block_store, upgrade_v24_v25)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Direct lmdb operations are used to simulate the old ledger format so this test will not work on RocksDB
+		GTEST_SKIP ();
+	}
+
+	auto path (nano::unique_path () / "data.ldb");
+	nano::logger logger;
+	nano::block_builder builder;
+	auto block = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (0)
+				 .build ();
+	nano::block_sideband sideband{ nano::dev::genesis_key.pub, 0, nano::dev::constants.genesis_amount - 1, 2, nano::seconds_since_epoch (), nano::epoch::epoch_0, true, false, false, nano::epoch::epoch_0 };
+	auto const size_v24 = sizeof (nano::block_type) + nano::state_block::size + nano::block_sideband::size_v24 (nano::block_type::state);
+
+	// Setting the database to its 24th version state with a block in the fixed width sideband format
+	{
+		nano::store::lmdb::component store (logger, path, nano::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		std::vector<uint8_t> vector;
+		{
+			nano::vectorstream stream (vector);
+			nano::serialize_block (stream, *block);
+			sideband.serialize_v24 (stream, block->type ());
+		}
+		ASSERT_EQ (size_v24, vector.size ());
+		store.block.raw_put (transaction, vector, block->hash ());
+		store.version.put (transaction, 24);
+	}
+
+	// Testing the upgrade code worked
+	{
+		nano::store::lmdb::component store (logger, path, nano::dev::constants);
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (store.version.get (transaction), store.version_current);
+		auto upgraded = store.block.get (transaction, block->hash ());
+		ASSERT_NE (nullptr, upgraded);
+		ASSERT_EQ (*block, *upgraded);
+		ASSERT_EQ (sideband.height, upgraded->sideband ().height);
+		ASSERT_EQ (sideband.timestamp, upgraded->sideband ().timestamp);
+		ASSERT_EQ (sideband.details, upgraded->sideband ().details);
+		ASSERT_FALSE (store.block.successor (transaction, block->hash ()));
+		nano::store::lmdb::db_val value;
+		ASSERT_EQ (MDB_SUCCESS, store.get (transaction, nano::tables::blocks, block->hash (), value));
+		ASSERT_LT (value.size (), size_v24);
+	}
+}
+
+// Batches committed before an interrupted upgrade are already in the compact format and are skipped when resuming
+TEST (mdb_block_store, upgrade_v24_v25_interrupted)
+{
+	if (nano::rocksdb_config::using_rocksdb_in_tests ())
+	{
+		// Direct lmdb operations are used to simulate the old ledger format so this test will not work on RocksDB
+		GTEST_SKIP ();
+	}
+
+	auto path (nano::unique_path () / "data.ldb");
+	nano::logger logger;
+	nano::block_builder builder;
+	auto make_block = [&builder] (nano::amount const & balance) {
+		auto block = builder
+					 .state ()
+					 .account (nano::dev::genesis_key.pub)
+					 .previous (nano::dev::genesis->hash ())
+					 .representative (nano::dev::genesis_key.pub)
+					 .balance (balance)
+					 .link (nano::dev::genesis_key.pub)
+					 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					 .work (0)
+					 .build ();
+		return block;
+	};
+	auto block1 = make_block (nano::dev::constants.genesis_amount - 1);
+	auto block2 = make_block (nano::dev::constants.genesis_amount - 2);
+	auto block3 = make_block (nano::dev::constants.genesis_amount - 3);
+	nano::block_sideband sideband1{ nano::dev::genesis_key.pub, 0, nano::dev::constants.genesis_amount - 1, 2, nano::seconds_since_epoch (), nano::epoch::epoch_0, true, false, false, nano::epoch::epoch_0 };
+	nano::block_sideband sideband2{ nano::dev::genesis_key.pub, 0, nano::dev::constants.genesis_amount - 2, 3, nano::seconds_since_epoch (), nano::epoch::epoch_0, true, false, false, nano::epoch::epoch_0 };
+	// 9 byte height and 7 byte timestamp, as long as the fixed width fields
+	nano::block_sideband sideband3{ nano::dev::genesis_key.pub, 0, nano::dev::constants.genesis_amount - 3, 1ULL << 62, 1ULL << 42, nano::epoch::epoch_0, true, false, false, nano::epoch::epoch_0 };
+	ASSERT_EQ (nano::block_sideband::size_v24 (nano::block_type::state), sideband3.size (nano::block_type::state));
+
+	// Only the first block still uses the fixed width sideband format
+	{
+		nano::store::lmdb::component store (logger, path, nano::dev::constants);
+		auto transaction (store.tx_begin_write ());
+		auto put = [&] (nano::block const & block, nano::block_sideband const & sideband, bool compact) {
+			std::vector<uint8_t> vector;
+			{
+				nano::vectorstream stream (vector);
+				nano::serialize_block (stream, block);
+				compact ? sideband.serialize (stream, block.type ()) : sideband.serialize_v24 (stream, block.type ());
+			}
+			store.block.raw_put (transaction, vector, block.hash ());
+		};
+		put (*block1, sideband1, false);
+		put (*block2, sideband2, true);
+		put (*block3, sideband3, true);
+		store.version.put (transaction, 24);
+	}
+
+	{
+		nano::store::lmdb::component store (logger, path, nano::dev::constants);
+		auto transaction (store.tx_begin_read ());
+		ASSERT_EQ (store.version.get (transaction), store.version_current);
+		for (auto const & [block, sideband] : { std::make_pair (block1, sideband1), std::make_pair (block2, sideband2), std::make_pair (block3, sideband3) })
+		{
+			auto upgraded = store.block.get (transaction, block->hash ());
+			ASSERT_NE (nullptr, upgraded);
+			ASSERT_EQ (*block, *upgraded);
+			ASSERT_EQ (sideband.height, upgraded->sideband ().height);
+			ASSERT_EQ (sideband.timestamp, upgraded->sideband ().timestamp);
+			ASSERT_EQ (sideband.details, upgraded->sideband ().details);
+		}
+	}
+}
 }
 
 namespace nano::store::rocksdb
@@ -1761,3 +2094,147 @@ TEST (rocksdb_block_store, tombstone_count)
 	ASSERT_TIMELY_EQ (5s, store->tombstone_map.at (nano::tables::accounts).num_since_last_flush.load (), 1);
 }
 }
+
+TEST (memory_block_store, read_snapshot)
+{
+	auto store = nano::test::make_memory_store ();
+	ASSERT_FALSE (store->init_error ());
+	{
+		auto transaction = store->tx_begin_write ();
+		store->online_weight.put (transaction, 1, 2);
+	}
+	auto snapshot = store->tx_begin_read ();
+	{
+		auto transaction = store->tx_begin_write ();
+		store->online_weight.put (transaction, 3, 4);
+		store->online_weight.del (transaction, 1);
+		// Uncommitted writes are visible to the writer only
+		ASSERT_EQ (1, store->online_weight.count (transaction));
+		ASSERT_EQ (3, store->online_weight.begin (transaction)->first);
+		ASSERT_EQ (1, store->online_weight.count (snapshot));
+	}
+	// Committed writes are not visible to an existing snapshot until it is renewed
+	ASSERT_EQ (1, store->online_weight.count (snapshot));
+	ASSERT_EQ (1, store->online_weight.begin (snapshot)->first);
+	ASSERT_EQ (2, store->online_weight.begin (snapshot)->second.number ());
+	snapshot.refresh ();
+	ASSERT_EQ (1, store->online_weight.count (snapshot));
+	ASSERT_EQ (3, store->online_weight.begin (snapshot)->first);
+	ASSERT_EQ (4, store->online_weight.begin (snapshot)->second.number ());
+}
+
+TEST (memory_block_store, snapshot_release_prunes)
+{
+	auto store = nano::test::make_memory_store ();
+	ASSERT_FALSE (store->init_error ());
+	auto stats = [&store] () {
+		boost::property_tree::ptree json;
+		store->serialize_memory_stats (json);
+		return std::make_tuple (json.get<size_t> ("entries"), json.get<size_t> ("versions"), json.get<size_t> ("deferred"));
+	};
+	{
+		auto transaction = store->tx_begin_write ();
+		store->online_weight.put (transaction, 1, 2);
+		store->online_weight.put (transaction, 3, 4);
+	}
+	auto [entries, versions, deferred] = stats ();
+	ASSERT_EQ (entries, versions);
+	ASSERT_EQ (0, deferred);
+	auto snapshot = store->tx_begin_read ();
+	{
+		auto transaction = store->tx_begin_write ();
+		store->online_weight.put (transaction, 1, 5);
+		store->online_weight.del (transaction, 3);
+	}
+	// Both old versions are retained for the snapshot
+	ASSERT_EQ (std::make_tuple (entries, versions + 2, size_t{ 2 }), stats ());
+	ASSERT_EQ (2, store->online_weight.count (snapshot));
+	snapshot.reset ();
+	// The overwritten version and the deleted entry are reclaimed
+	ASSERT_EQ (std::make_tuple (entries - 1, versions - 1, size_t{ 0 }), stats ());
+}
+
+// Only releasing the oldest snapshot lets deferred versions go
+TEST (memory_block_store, snapshot_release_oldest)
+{
+	auto store = nano::test::make_memory_store ();
+	ASSERT_FALSE (store->init_error ());
+	auto deferred = [&store] () {
+		boost::property_tree::ptree json;
+		store->serialize_memory_stats (json);
+		return json.get<size_t> ("deferred");
+	};
+	{
+		auto transaction = store->tx_begin_write ();
+		store->online_weight.put (transaction, 1, 2);
+	}
+	auto snapshot1 = store->tx_begin_read ();
+	auto snapshot2 = store->tx_begin_read ();
+	{
+		auto transaction = store->tx_begin_write ();
+		store->online_weight.put (transaction, 1, 3);
+	}
+	auto snapshot3 = store->tx_begin_read ();
+	ASSERT_EQ (1, deferred ());
+	// Newer snapshots and duplicates of the oldest one keep the version
+	snapshot3.reset ();
+	ASSERT_EQ (1, deferred ());
+	snapshot1.reset ();
+	ASSERT_EQ (1, deferred ());
+	snapshot2.reset ();
+	ASSERT_EQ (0, deferred ());
+}
+
+TEST (memory_block_store, iteration_order)
+{
+	auto store = nano::test::make_memory_store ();
+	ASSERT_FALSE (store->init_error ());
+	{
+		auto transaction = store->tx_begin_write ();
+		for (uint64_t i = 10; i > 0; --i)
+		{
+			store->online_weight.put (transaction, i, i * 2);
+		}
+		store->online_weight.del (transaction, 5);
+		store->online_weight.del (transaction, 10);
+	}
+	auto transaction = store->tx_begin_read ();
+	std::vector<uint64_t> forward;
+	for (auto i = store->online_weight.begin (transaction), n = store->online_weight.end (); i != n; ++i)
+	{
+		forward.push_back (i->first);
+	}
+	ASSERT_EQ ((std::vector<uint64_t>{ 1, 2, 3, 4, 6, 7, 8, 9 }), forward);
+	std::vector<uint64_t> backward;
+	for (auto i = store->online_weight.rbegin (transaction), n = store->online_weight.end (); i != n; --i)
+	{
+		backward.push_back (i->first);
+	}
+	ASSERT_EQ ((std::vector<uint64_t>{ 9, 8, 7, 6, 4, 3, 2, 1 }), backward);
+}
+
+TEST (memory_block_store, ledger)
+{
+	nano::logger logger;
+	auto store = nano::test::make_memory_store ();
+	nano::stats stats{ logger };
+	nano::ledger ledger (*store, stats, nano::dev::constants);
+	nano::work_pool pool{ nano::dev::network_params.network, 1 };
+	store->initialize (ledger.tx_begin_write (), ledger.cache, nano::dev::constants);
+	nano::block_builder builder;
+	auto send = builder
+				.state ()
+				.account (nano::dev::genesis_key.pub)
+				.previous (nano::dev::genesis->hash ())
+				.representative (nano::dev::genesis_key.pub)
+				.balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				.link (nano::dev::genesis_key.pub)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*pool.generate (nano::dev::genesis->hash ()))
+				.build ();
+	ASSERT_EQ (nano::block_status::progress, ledger.process (ledger.tx_begin_write (), send));
+	auto transaction = ledger.tx_begin_read ();
+	ASSERT_TRUE (ledger.any.block_exists (transaction, send->hash ()));
+	ASSERT_EQ (send->hash (), ledger.any.block_successor (transaction, nano::dev::genesis->hash ()));
+	ASSERT_EQ (2, store->block.count (transaction));
+}
@@ -25,7 +25,7 @@ TEST (confirmation_solicitor, batches)
 	// Solicitor will only solicit from this representative
 	nano::representative representative{ nano::dev::genesis_key.pub, channel1 };
 	std::vector<nano::representative> representatives{ representative };
-	nano::confirmation_solicitor solicitor (node2.network, node2.config);
+	nano::confirmation_solicitor solicitor (node2.network, node2.online_reps, node2.config);
 	solicitor.prepare (representatives);
 	// Ensure the representatives are correct
 	ASSERT_EQ (1, representatives.size ());
@@ -75,7 +75,7 @@ TEST (confirmation_solicitor, different_hash)
 	// Solicitor will only solicit from this representative
 	nano::representative representative{ nano::dev::genesis_key.pub, channel1 };
 	std::vector<nano::representative> representatives{ representative };
-	nano::confirmation_solicitor solicitor (node2.network, node2.config);
+	nano::confirmation_solicitor solicitor (node2.network, node2.online_reps, node2.config);
 	solicitor.prepare (representatives);
 	// Ensure the representatives are correct
 	ASSERT_EQ (1, representatives.size ());
@@ -112,7 +112,7 @@ TEST (confirmation_solicitor, bypass_max_requests_cap)
 	node_flags.disable_rep_crawler = true;
 	auto & node1 = *system.add_node (node_flags);
 	auto & node2 = *system.add_node (node_flags);
-	nano::confirmation_solicitor solicitor (node2.network, node2.config);
+	nano::confirmation_solicitor solicitor (node2.network, node2.online_reps, node2.config);
 	std::vector<nano::representative> representatives;
 	auto max_representatives = std::max<size_t> (solicitor.max_election_requests, solicitor.max_election_broadcasts);
 	representatives.reserve (max_representatives + 1);
@@ -158,4 +158,136 @@ TEST (confirmation_solicitor, bypass_max_requests_cap)
 	// All requests but one went through, due to the cap
 	ASSERT_EQ (2 * max_representatives + 1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
 }
+
+TEST (confirmation_solicitor, batches_across_iterations)
+{
+	nano::test::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_request_loop = true;
+	node_flags.disable_rep_crawler = true;
+	auto & node1 = *system.add_node (node_flags);
+	auto config = system.default_config ();
+	config.active_elections.confirm_req_window = 500ms;
+	auto & node2 = *system.add_node (config, node_flags);
+	auto channel1 = nano::test::establish_tcp (system, node2, node1.network.endpoint ());
+	std::vector<nano::representative> representatives{ { nano::dev::genesis_key.pub, channel1 } };
+	nano::confirmation_solicitor solicitor (node2.network, node2.online_reps, node2.config);
+	ASSERT_TIMELY_EQ (3s, node2.network.size (), 1);
+	nano::block_builder builder;
+	auto make_election = [&] (nano::uint128_t balance) {
+		auto send = builder
+					.send ()
+					.previous (nano::dev::genesis->hash ())
+					.destination (nano::keypair ().pub)
+					.balance (balance)
+					.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					.work (0)
+					.build ();
+		send->sideband_set ({});
+		return std::make_shared<nano::election> (node2, send, nullptr, nullptr, nano::election_behavior::priority);
+	};
+	auto election1 = make_election (nano::dev::constants.genesis_amount - 100);
+	auto election2 = make_election (nano::dev::constants.genesis_amount - 200);
+	// A single request is held back for the window
+	solicitor.prepare (representatives);
+	ASSERT_FALSE (solicitor.add (*election1));
+	solicitor.flush ();
+	ASSERT_EQ (1, solicitor.pending ());
+	// The next iteration adds to the same packet, requests for the same hash are not repeated
+	solicitor.prepare (representatives);
+	ASSERT_FALSE (solicitor.add (*election1));
+	ASSERT_FALSE (solicitor.add (*election2));
+	solicitor.flush ();
+	ASSERT_EQ (2, solicitor.pending ());
+	ASSERT_EQ (0, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+	// Sent as a single packet once the window passed
+	std::this_thread::sleep_for (500ms);
+	solicitor.prepare (representatives);
+	solicitor.flush ();
+	ASSERT_EQ (0, solicitor.pending ());
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+}
+
+TEST (confirmation_solicitor, closest_to_quorum_first)
+{
+	nano::test::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_request_loop = true;
+	node_flags.disable_rep_crawler = true;
+	auto & node1 = *system.add_node (node_flags);
+	auto config = system.default_config ();
+	config.active_elections.confirm_req_window = 1min;
+	auto & node2 = *system.add_node (config, node_flags);
+	auto channel1 = nano::test::establish_tcp (system, node2, node1.network.endpoint ());
+	std::vector<nano::representative> representatives{ { nano::dev::genesis_key.pub, channel1 } };
+	nano::confirmation_solicitor solicitor (node2.network, node2.online_reps, node2.config);
+	ASSERT_TIMELY_EQ (3s, node2.network.size (), 1);
+	nano::block_builder builder;
+	std::vector<std::shared_ptr<nano::election>> elections;
+	for (size_t i = 0; i < nano::network::confirm_req_hashes_max + 1; ++i)
+	{
+		auto send = builder
+					.send ()
+					.previous (nano::dev::genesis->hash ())
+					.destination (nano::keypair ().pub)
+					.balance (nano::dev::constants.genesis_amount - 100 - i)
+					.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					.work (0)
+					.build ();
+		send->sideband_set ({});
+		elections.push_back (std::make_shared<nano::election> (node2, send, nullptr, nullptr, nano::election_behavior::priority));
+	}
+	// All elections are queued with the same tally
+	solicitor.prepare (representatives);
+	for (auto const & election : elections)
+	{
+		ASSERT_FALSE (solicitor.add (*election));
+	}
+	// Every election but the oldest one gains enough weight for quorum before the flush
+	for (auto i = std::next (elections.begin ()); i != elections.end (); ++i)
+	{
+		(*i)->status.tally = node2.online_reps.delta ();
+	}
+	solicitor.flush ();
+	ASSERT_EQ (1, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+	// The oldest election is furthest from quorum and waits for the next packet
+	ASSERT_EQ (1, solicitor.pending ());
+	ASSERT_TRUE (solicitor.pending (elections.front ()->winner ()->hash ()));
+}
+
+TEST (confirmation_solicitor, drop_ended_elections)
+{
+	nano::test::system system;
+	nano::node_flags node_flags;
+	node_flags.disable_request_loop = true;
+	node_flags.disable_rep_crawler = true;
+	auto & node1 = *system.add_node (node_flags);
+	auto config = system.default_config ();
+	config.active_elections.confirm_req_window = 0ms;
+	auto & node2 = *system.add_node (config, node_flags);
+	auto channel1 = nano::test::establish_tcp (system, node2, node1.network.endpoint ());
+	std::vector<nano::representative> representatives{ { nano::dev::genesis_key.pub, channel1 } };
+	nano::confirmation_solicitor solicitor (node2.network, node2.online_reps, node2.config);
+	ASSERT_TIMELY_EQ (3s, node2.network.size (), 1);
+	nano::block_builder builder;
+	auto send = builder
+				.send ()
+				.previous (nano::dev::genesis->hash ())
+				.destination (nano::keypair ().pub)
+				.balance (nano::dev::constants.genesis_amount - 100)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (0)
+				.build ();
+	send->sideband_set ({});
+	auto election = std::make_shared<nano::election> (node2, send, nullptr, nullptr, nano::election_behavior::priority);
+	solicitor.prepare (representatives);
+	ASSERT_FALSE (solicitor.add (*election));
+	ASSERT_EQ (1, solicitor.pending ());
+	// The election is gone before its held request is sent
+	election.reset ();
+	solicitor.flush ();
+	ASSERT_EQ (0, solicitor.pending ());
+	ASSERT_FALSE (solicitor.pending (send->hash ()));
+	ASSERT_EQ (0, node2.stats.count (nano::stat::type::message, nano::stat::detail::confirm_req, nano::stat::dir::out));
+}
 }
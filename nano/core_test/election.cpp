@@ -259,11 +259,16 @@ TEST (election, quorum_minimum_update_weight_before_quorum_checks)
 	node1.rep_crawler.force_process (vote2, channel);
 
 	ASSERT_FALSE (election->confirmed ());
+	// Online weight follows ledger weight changes of online reps without waiting for their next vote
+	nano::uint128_t expected{ 0 };
 	{
 		nano::lock_guard<nano::mutex> guard (node1.online_reps.mutex);
-		// Modify online_m for online_reps to more than is available, this checks that voting below updates it to current online reps.
-		node1.online_reps.online_m = node_config.online_weight_minimum.number () + 20;
+		for (auto const & rep : node1.online_reps.reps)
+		{
+			expected += node1.ledger.weight (rep.account);
+		}
 	}
+	ASSERT_EQ (expected, node1.online_reps.online ());
 	ASSERT_EQ (nano::vote_code::vote, node1.vote_router.vote (vote2).at (send1->hash ()));
 	ASSERT_TIMELY (5s, election->confirmed ());
 	ASSERT_NE (nullptr, node1.block (send1->hash ()));
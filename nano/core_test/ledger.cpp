@@ -5855,4 +5855,123 @@ TEST (ledger_transaction, write_wait_order)
 
 	// Signal to continue and drop the third transaction
 	latch3.count_down ();
-}
\ No newline at end of file
+}
+
+TEST (write_queue, priority_order)
+{
+	nano::test::system system;
+	nano::store::write_queue_config config;
+	config.aging_interval = 0ms;
+	nano::store::write_queue queue{ false, config };
+
+	nano::mutex mutex;
+	std::vector<nano::store::writer> order;
+	auto record = [&] (nano::store::writer writer) {
+		auto guard = queue.wait (writer);
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		order.push_back (writer);
+	};
+
+	auto guard = queue.wait (nano::store::writer::testing);
+	auto fut1 = std::async (std::launch::async, record, nano::store::writer::pruning);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::pruning));
+	auto fut2 = std::async (std::launch::async, record, nano::store::writer::blockprocessor);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::blockprocessor));
+
+	// Blockprocessor arrived last but has higher priority
+	guard.release ();
+	fut1.wait ();
+	fut2.wait ();
+	ASSERT_EQ (order, (std::vector<nano::store::writer>{ nano::store::writer::blockprocessor, nano::store::writer::pruning }));
+}
+
+TEST (write_queue, priority_aging)
+{
+	nano::test::system system;
+	nano::store::write_queue_config config;
+	config.aging_interval = 10ms;
+	nano::store::write_queue queue{ false, config };
+
+	nano::mutex mutex;
+	std::vector<nano::store::writer> order;
+	auto record = [&] (nano::store::writer writer) {
+		auto guard = queue.wait (writer);
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		order.push_back (writer);
+	};
+
+	auto guard = queue.wait (nano::store::writer::testing);
+	auto fut1 = std::async (std::launch::async, record, nano::store::writer::pruning);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::pruning));
+	WAIT (500ms); // Long enough for pruning to age past blockprocessor priority
+	auto fut2 = std::async (std::launch::async, record, nano::store::writer::blockprocessor);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::blockprocessor));
+
+	guard.release ();
+	fut1.wait ();
+	fut2.wait ();
+	ASSERT_EQ (order, (std::vector<nano::store::writer>{ nano::store::writer::pruning, nano::store::writer::blockprocessor }));
+}
+
+// Writers waiting for many hold periods must not overtake a high priority writer until the aging interval catches up
+TEST (write_queue, aging_no_starvation)
+{
+	nano::test::system system;
+	nano::store::write_queue_config config;
+	config.max_hold = 10ms;
+	config.aging_interval = 1h;
+	nano::store::write_queue queue{ false, config };
+
+	nano::mutex mutex;
+	std::vector<nano::store::writer> order;
+	auto record = [&] (nano::store::writer writer) {
+		auto guard = queue.wait (writer);
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		order.push_back (writer);
+	};
+
+	auto guard = queue.wait (nano::store::writer::testing);
+	auto fut1 = std::async (std::launch::async, record, nano::store::writer::pruning);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::pruning));
+	auto fut2 = std::async (std::launch::async, record, nano::store::writer::node);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::node));
+	WAIT (500ms); // Many times max_hold
+	auto fut3 = std::async (std::launch::async, record, nano::store::writer::blockprocessor);
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::blockprocessor));
+
+	guard.release ();
+	fut1.wait ();
+	fut2.wait ();
+	fut3.wait ();
+	ASSERT_EQ (order, (std::vector<nano::store::writer>{ nano::store::writer::blockprocessor, nano::store::writer::node, nano::store::writer::pruning }));
+}
+
+TEST (write_queue, should_yield)
+{
+	nano::test::system system;
+	nano::store::write_queue_config config;
+	config.max_hold = 100ms;
+	nano::store::write_queue queue{ false, config };
+
+	std::atomic<std::chrono::steady_clock::duration> waited{};
+	queue.acquired.add ([&] (nano::store::writer writer, auto duration) {
+		if (writer == nano::store::writer::blockprocessor)
+		{
+			waited = duration;
+		}
+	});
+
+	auto guard = queue.wait (nano::store::writer::pruning);
+	ASSERT_FALSE (guard.should_yield ());
+
+	auto fut = std::async (std::launch::async, [&] {
+		auto guard = queue.wait (nano::store::writer::blockprocessor);
+	});
+	ASSERT_TIMELY (5s, queue.contains (nano::store::writer::blockprocessor));
+
+	// Only asked to yield once the hold time hint is exceeded
+	ASSERT_TIMELY (5s, guard.should_yield ());
+	guard.release ();
+	fut.wait ();
+	ASSERT_GT (waited.load (), std::chrono::steady_clock::duration::zero ());
+}
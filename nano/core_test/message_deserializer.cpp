@@ -17,6 +17,9 @@ auto message_deserializer_success_checker (message_type & message_original) -> v
 	nano::network_filter filter (1);
 	nano::block_uniquer block_uniquer;
 	nano::vote_uniquer vote_uniquer;
+	nano::logger logger;
+	nano::stats stats{ logger };
+	nano::transport::buffer_pool buffer_pool{ nano::transport::message_deserializer::MAX_MESSAGE_SIZE, 1, stats };
 
 	// Data used to simulate the incoming buffer to be deserialized, the offset tracks how much has been read from the input_source
 	// as the read function is called first to read the header, then called again to read the payload.
@@ -24,7 +27,7 @@ auto message_deserializer_success_checker (message_type & message_original) -> v
 	std::size_t offset{ 0 };
 
 	// Message Deserializer with the query function tweaked to read from the `input_source`.
-	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, filter, block_uniquer, vote_uniquer,
+	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, filter, block_uniquer, vote_uniquer, buffer_pool,
 	[&input_source, &offset] (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
 		debug_assert (input_source.size () >= size_a);
 		data_a->resize (size_a);
@@ -203,3 +206,54 @@ TEST (message_deserializer, exact_asc_pull_ack)
 
 	message_deserializer_success_checker<decltype (message)> (message);
 }
+
+TEST (message_deserializer, buffer_reuse)
+{
+	nano::network_filter filter (1);
+	nano::block_uniquer block_uniquer;
+	nano::vote_uniquer vote_uniquer;
+	nano::logger logger;
+	nano::stats stats{ logger };
+	nano::transport::buffer_pool buffer_pool{ nano::transport::message_deserializer::MAX_MESSAGE_SIZE, 1, stats };
+
+	std::vector<uint8_t> input_source;
+	std::size_t offset{ 0 };
+	auto const message_deserializer = std::make_shared<nano::transport::message_deserializer> (nano::dev::network_params.network, filter, block_uniquer, vote_uniquer, buffer_pool,
+	[&input_source, &offset] (std::shared_ptr<std::vector<uint8_t>> const & data_a, std::size_t size_a, std::function<void (boost::system::error_code const &, std::size_t)> callback_a) {
+		data_a->resize (size_a);
+		auto const copy_start = input_source.begin () + offset;
+		std::copy (copy_start, copy_start + size_a, data_a->data ());
+		offset += size_a;
+		callback_a (boost::system::errc::make_error_code (boost::system::errc::success), size_a);
+	});
+
+	for (auto i = 0; i < 3; ++i)
+	{
+		nano::keepalive message{ nano::dev::network_params.network };
+		{
+			nano::vectorstream stream (input_source);
+			message.serialize (stream);
+		}
+		message_deserializer->read ([] (boost::system::error_code ec, std::unique_ptr<nano::message> message) {
+			ASSERT_FALSE (ec);
+			ASSERT_NE (nullptr, message);
+		});
+		ASSERT_EQ (message_deserializer->status, nano::transport::parse_status::success);
+	}
+
+	// The payload buffer is allocated once and reused for the following messages
+	ASSERT_EQ (1, stats.count (nano::stat::type::buffer_pool, nano::stat::detail::allocate));
+	ASSERT_EQ (2, stats.count (nano::stat::type::buffer_pool, nano::stat::detail::reuse));
+	ASSERT_EQ (1, buffer_pool.size ());
+
+	// Messages without payload do not take a buffer
+	nano::telemetry_req telemetry_req{ nano::dev::network_params.network };
+	{
+		nano::vectorstream stream (input_source);
+		telemetry_req.serialize (stream);
+	}
+	message_deserializer->read ([] (boost::system::error_code ec, std::unique_ptr<nano::message> message) {
+		ASSERT_NE (nullptr, message);
+	});
+	ASSERT_EQ (2, stats.count (nano::stat::type::buffer_pool, nano::stat::detail::reuse));
+}
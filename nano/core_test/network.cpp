@@ -1,9 +1,11 @@
 #include <nano/lib/blocks.hpp>
+#include <nano/node/bandwidth_limiter.hpp>
 #include <nano/node/election.hpp>
 #include <nano/node/network.hpp>
 #include <nano/node/nodeconfig.hpp>
 #include <nano/node/scheduler/component.hpp>
 #include <nano/node/scheduler/priority.hpp>
+#include <nano/node/transport/fake.hpp>
 #include <nano/node/transport/inproc.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
@@ -905,6 +907,135 @@ TEST (network, bandwidth_limiter_with_burst)
 	ASSERT_TIMELY_EQ (1s, 0, node.stats.count (nano::stat::type::drop, nano::stat::detail::publish, nano::stat::dir::out));
 }
 
+// Socket writes over the limit wait in the shaper instead of being dropped and are resumed once tokens are refilled
+TEST (bandwidth_limiter, shaper_queue)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.bandwidth_limit = 1000;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	nano::stats stats{ system.logger };
+	nano::bandwidth_limiter limiter{ node_config, stats };
+	limiter.start ();
+
+	// The first write uses up the whole budget
+	ASSERT_TRUE (limiter.acquire (1000, nano::transport::traffic_type::generic, nullptr));
+
+	nano::mutex mutex;
+	std::vector<int> resumed;
+	auto resume = [&] (int id) {
+		return [&, id] () {
+			nano::lock_guard<nano::mutex> guard{ mutex };
+			resumed.push_back (id);
+		};
+	};
+	ASSERT_FALSE (limiter.acquire (100, nano::transport::traffic_type::generic, resume (1)));
+	ASSERT_FALSE (limiter.acquire (100, nano::transport::traffic_type::generic, resume (2)));
+	// Writes larger than the bucket are still granted eventually
+	ASSERT_FALSE (limiter.acquire (5000, nano::transport::traffic_type::generic, resume (3)));
+	ASSERT_EQ (3, limiter.waiting (nano::transport::traffic_type::generic));
+
+	// Bootstrap traffic has its own budget
+	ASSERT_TRUE (limiter.acquire (1000, nano::transport::traffic_type::bootstrap, nullptr));
+
+	ASSERT_TIMELY_EQ (5s, limiter.waiting (nano::transport::traffic_type::generic), 0);
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		ASSERT_EQ ((std::vector<int>{ 1, 2, 3 }), resumed);
+	}
+	ASSERT_EQ (2, stats.count (nano::stat::type::bandwidth_shaper, nano::stat::detail::granted));
+	ASSERT_EQ (3, stats.count (nano::stat::type::bandwidth_shaper, nano::stat::detail::queued));
+	ASSERT_EQ (3, stats.count (nano::stat::type::bandwidth_shaper, nano::stat::detail::resumed));
+	limiter.stop ();
+}
+
+// Small writes from one peer are not stuck behind a large write from another peer
+TEST (bandwidth_limiter, shaper_fairness)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.bandwidth_limit = 100 * 1024;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	nano::stats stats{ system.logger };
+	nano::bandwidth_limiter limiter{ node_config, stats };
+	limiter.start ();
+
+	ASSERT_TRUE (limiter.acquire (100 * 1024, nano::transport::traffic_type::generic, nullptr));
+
+	nano::mutex mutex;
+	std::vector<int> resumed;
+	auto resume = [&] (int id) {
+		return [&, id] () {
+			nano::lock_guard<nano::mutex> guard{ mutex };
+			resumed.push_back (id);
+		};
+	};
+	ASSERT_FALSE (limiter.acquire (64 * 1024, nano::transport::traffic_type::generic, resume (1)));
+	ASSERT_FALSE (limiter.acquire (1024, nano::transport::traffic_type::generic, resume (2)));
+
+	ASSERT_TIMELY_EQ (5s, limiter.waiting (nano::transport::traffic_type::generic), 0);
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	ASSERT_EQ ((std::vector<int>{ 2, 1 }), resumed);
+	limiter.stop ();
+}
+
+// Without a running shaper writes are never delayed
+TEST (bandwidth_limiter, shaper_not_started)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.bandwidth_limit = 1000;
+	node_config.bandwidth_limit_burst_ratio = 1.0;
+	nano::stats stats{ system.logger };
+	nano::bandwidth_limiter limiter{ node_config, stats };
+	ASSERT_TRUE (limiter.acquire (1000, nano::transport::traffic_type::generic, nullptr));
+	ASSERT_TRUE (limiter.acquire (1000, nano::transport::traffic_type::generic, nullptr));
+	ASSERT_EQ (0, limiter.waiting (nano::transport::traffic_type::generic));
+}
+
+// A flood of one message type from a peer only fills the queue for that type
+TEST (message_processor, per_type_queues)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.message_processor.threads = 0; // Nothing is processed, messages stay queued
+	auto & node = *system.add_node (config);
+	auto channel = std::make_shared<nano::transport::fake::channel> (node);
+
+	auto const max_control = config.message_processor.max_control_queue;
+	for (size_t n = 0; n < max_control * 2; ++n)
+	{
+		node.message_processor.put (std::make_unique<nano::keepalive> (nano::dev::network_params.network), channel);
+	}
+	ASSERT_EQ (max_control, node.message_processor.size (nano::message_type::keepalive));
+	ASSERT_EQ (max_control, node.stats.count (nano::stat::type::message_processor_overfill, nano::stat::detail::keepalive));
+
+	// Publish messages from the same peer are queued separately
+	ASSERT_TRUE (node.message_processor.put (std::make_unique<nano::publish> (nano::dev::network_params.network, nano::dev::genesis), channel));
+	ASSERT_EQ (1, node.message_processor.size (nano::message_type::publish));
+	ASSERT_EQ (max_control, node.message_processor.size (nano::message_type::keepalive));
+}
+
+TEST (message_processor, fast_vote_routing)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.message_processor.threads = 0; // Only routed votes can make progress
+	config.message_processor.fast_vote_routing = true;
+	auto & node = *system.add_node (config);
+	auto channel = std::make_shared<nano::transport::fake::channel> (node);
+
+	auto vote = nano::test::make_vote (nano::dev::genesis_key, { nano::dev::genesis->hash () });
+	ASSERT_TRUE (node.message_processor.put (std::make_unique<nano::confirm_ack> (nano::dev::network_params.network, vote), channel));
+	ASSERT_EQ (0, node.message_processor.size (nano::message_type::confirm_ack));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::message_processor, nano::stat::detail::fast_route));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::process));
+
+	// Other messages are still queued
+	ASSERT_TRUE (node.message_processor.put (std::make_unique<nano::publish> (nano::dev::network_params.network, nano::dev::genesis), channel));
+	ASSERT_EQ (1, node.message_processor.size (nano::message_type::publish));
+}
+
 namespace nano
 {
 TEST (peer_exclusion, validate)
@@ -1585,6 +1585,39 @@ TEST (node, online_reps)
 	ASSERT_EQ (node1.config.online_weight_minimum, node1.online_reps.trended ());
 }
 
+TEST (node, online_reps_weight_change)
+{
+	nano::test::system system;
+	auto & node1 = *system.add_node ();
+	node1.online_reps.observe (nano::dev::genesis_key.pub);
+	ASSERT_EQ (nano::dev::constants.genesis_amount, node1.online_reps.online ());
+	nano::keypair key;
+	auto send = nano::send_block_builder{}.make_block ()
+				.previous (nano::dev::genesis->hash ())
+				.destination (key.pub)
+				.balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*system.work.generate (nano::dev::genesis->hash ()))
+				.build ();
+	ASSERT_EQ (nano::block_status::progress, node1.process (send));
+	// Online weight follows the ledger without the representative voting again
+	ASSERT_EQ (nano::dev::constants.genesis_amount - nano::Gxrb_ratio, node1.online_reps.online ());
+	ASSERT_FALSE (node1.ledger.rollback (node1.ledger.tx_begin_write (), send->hash ()));
+	ASSERT_EQ (nano::dev::constants.genesis_amount, node1.online_reps.online ());
+	// Weight changes of representatives that are not online are ignored
+	ASSERT_EQ (nano::block_status::progress, node1.process (send));
+	auto open = nano::open_block_builder{}.make_block ()
+				.source (send->hash ())
+				.representative (key.pub)
+				.account (key.pub)
+				.sign (key.prv, key.pub)
+				.work (*system.work.generate (key.pub))
+				.build ();
+	ASSERT_EQ (nano::block_status::progress, node1.process (open));
+	ASSERT_EQ (nano::Gxrb_ratio, node1.ledger.weight (key.pub));
+	ASSERT_EQ (nano::dev::constants.genesis_amount - nano::Gxrb_ratio, node1.online_reps.online ());
+}
+
 TEST (node, online_reps_rep_crawler)
 {
 	nano::test::system system;
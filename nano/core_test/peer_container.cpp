@@ -171,6 +171,31 @@ TEST (channels, fill_random_part)
 	ASSERT_TRUE (std::all_of (target.begin () + half, target.end (), [] (nano::endpoint const & endpoint_a) { return endpoint_a == nano::endpoint (boost::asio::ip::address_v6::any (), 0); }));
 }
 
+// Readers see an immutable snapshot that is replaced when channels are added or removed
+TEST (channels, snapshot)
+{
+	nano::test::system system{ 1 };
+	auto & node = *system.nodes[0];
+	auto initial = node.network.tcp_channels.current ();
+	ASSERT_TRUE (initial->channels.empty ());
+
+	auto outer_node = nano::test::add_outer_node (system);
+	auto channel = nano::test::establish_tcp (system, node, outer_node->network.endpoint ());
+	ASSERT_NE (nullptr, channel);
+
+	auto snapshot = node.network.tcp_channels.current ();
+	ASSERT_NE (initial, snapshot);
+	ASSERT_TRUE (initial->channels.empty ()); // Previous snapshot is unchanged
+	ASSERT_EQ (1, snapshot->channels.size ());
+	ASSERT_EQ (channel, node.network.tcp_channels.find_node_id (outer_node->get_node_id ()));
+	ASSERT_EQ (channel, node.network.tcp_channels.find_channel (channel->get_tcp_endpoint ()));
+
+	node.network.tcp_channels.erase (channel->get_tcp_endpoint ());
+	ASSERT_EQ (1, snapshot->channels.size ());
+	ASSERT_EQ (0, node.network.tcp_channels.size ());
+	ASSERT_EQ (nullptr, node.network.tcp_channels.find_node_id (outer_node->get_node_id ()));
+}
+
 // TODO: remove node instantiation requirement for testing with bigger network size
 TEST (peer_container, list_fanout)
 {
@@ -54,14 +54,14 @@ TEST (request_aggregator, one)
 	ASSERT_TIMELY (3s, node.aggregator.empty ());
 	ASSERT_TIMELY (3s, 0 < node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
 
-	// Already cached
-	// TODO: This is outdated, aggregator should not be using cache
+	// Already signed, the vote is reused
 	node.aggregator.request (request, dummy_channel);
 	ASSERT_TIMELY (3s, node.aggregator.empty ());
 	ASSERT_TIMELY_EQ (3s, 3, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_accepted));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_dropped));
 	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
-	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
 }
@@ -191,8 +191,10 @@ TEST (request_aggregator, two)
 	ASSERT_EQ (2, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_accepted));
 	ASSERT_EQ (0, node.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_dropped));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
-	ASSERT_TIMELY_EQ (3s, 4, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
-	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_hashes));
+	ASSERT_TIMELY_EQ (3s, 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
 	ASSERT_TIMELY_EQ (3s, 0, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 	ASSERT_TIMELY_EQ (3s, 2, node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
 	// Make sure the cached vote is for both hashes
@@ -246,20 +248,130 @@ TEST (request_aggregator, two_endpoints)
 	ASSERT_TIMELY_EQ (5s, 1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
 	ASSERT_TIMELY_EQ (3s, 0, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 
-	// For the second request, aggregator should use the cache
-	// TODO: This is outdated, aggregator should not be using cache
-	node1.aggregator.request (request, dummy_channel1);
+	// For the second request, the vote signed for the first one is reused
+	node1.aggregator.request (request, dummy_channel2);
 	ASSERT_TIMELY (5s, node1.aggregator.empty ());
 
 	ASSERT_TIMELY_EQ (5s, 2, node1.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_accepted));
 	ASSERT_EQ (0, node1.stats.count (nano::stat::type::aggregator, nano::stat::detail::aggregator_dropped));
 
 	ASSERT_TIMELY_EQ (5s, 0, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
-	ASSERT_TIMELY_EQ (5s, 2, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
-	ASSERT_TIMELY_EQ (5s, 2, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_TIMELY_EQ (5s, 1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes));
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_EQ (1, node1.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_signatures_saved));
 	ASSERT_TIMELY_EQ (3s, 0, node1.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cannot_vote));
 }
 
+// Requests from many peers for the same block are answered with a single signed vote
+TEST (request_aggregator, coalesce_peers)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.backlog_population.enable = false;
+	auto & node (*system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*node.work_generate_blocking (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node.ledger.process (node.ledger.tx_begin_write (), send1));
+	nano::test::confirm (node.ledger, send1);
+
+	std::vector<std::pair<nano::block_hash, nano::root>> request{ { send1->hash (), send1->root () } };
+	size_t const peers = 8;
+	for (size_t n = 0; n < peers; ++n)
+	{
+		ASSERT_TRUE (node.aggregator.request (request, nano::test::fake_channel (node)));
+	}
+
+	ASSERT_TIMELY_EQ (5s, peers, node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_EQ (peers - 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+	ASSERT_EQ (peers - 1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_signatures_saved));
+}
+
+// Replies wait for votes still being signed on the pool, so they are reused with several signing threads as well
+TEST (request_aggregator, coalesce_peers_signing_threads)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.backlog_population.enable = false;
+	node_config.vote_generator_threads = 2;
+	auto & node (*system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*node.work_generate_blocking (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node.ledger.process (node.ledger.tx_begin_write (), send1));
+	nano::test::confirm (node.ledger, send1);
+
+	std::vector<std::pair<nano::block_hash, nano::root>> request{ { send1->hash (), send1->root () } };
+	size_t const peers = 8;
+	for (size_t n = 0; n < peers; ++n)
+	{
+		ASSERT_TRUE (node.aggregator.request (request, nano::test::fake_channel (node)));
+	}
+
+	ASSERT_TIMELY_EQ (5s, peers, node.stats.count (nano::stat::type::message, nano::stat::detail::confirm_ack, nano::stat::dir::out));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_generated_votes));
+	ASSERT_EQ (peers - 1, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_cached_votes));
+}
+
+TEST (request_aggregator, resolve_batch)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.backlog_population.enable = false;
+	auto & node (*system.add_node (node_config));
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*node.work_generate_blocking (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node.ledger.process (node.ledger.tx_begin_write (), send1));
+	nano::test::confirm (node.ledger, send1);
+
+	// The same hash requested twice by each peer, together with an unknown one
+	std::vector<std::pair<nano::block_hash, nano::root>> request{ { send1->hash (), send1->root () }, { send1->hash (), send1->root () }, { nano::block_hash{ 1 }, nano::root{ 1 } } };
+	size_t const peers = 4;
+	for (size_t n = 0; n < peers; ++n)
+	{
+		ASSERT_TRUE (node.aggregator.request (request, nano::test::fake_channel (node)));
+	}
+
+	ASSERT_TIMELY_EQ (5s, peers * request.size (), node.stats.count (nano::stat::type::request_aggregator, nano::stat::detail::batch_hashes));
+	// Every batch looks up each distinct hash once
+	auto const unique = node.stats.count (nano::stat::type::request_aggregator, nano::stat::detail::batch_hashes_unique);
+	ASSERT_LE (2, unique);
+	ASSERT_GE (2 * peers, unique);
+	// Each request is still answered separately
+	ASSERT_TIMELY_EQ (5s, 2 * peers, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_final));
+	ASSERT_EQ (peers, node.stats.count (nano::stat::type::requests, nano::stat::detail::requests_unknown));
+}
+
 TEST (request_aggregator, split)
 {
 	size_t max_vbh = nano::network::confirm_ack_hashes_max;
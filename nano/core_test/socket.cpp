@@ -2,6 +2,7 @@
 #include <nano/boost/asio/ip/network_v6.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/node/inactive_node.hpp>
+#include <nano/node/transport/io_pool.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 #include <nano/test_common/system.hpp>
@@ -476,6 +477,103 @@ TEST (socket, concurrent_writes)
 	}
 }
 
+TEST (socket_queue, pop_batch)
+{
+	nano::transport::socket_queue queue{ 16 };
+	auto make_buffer = [] (size_t size, uint8_t value) {
+		return nano::shared_const_buffer{ std::vector<uint8_t> (size, value) };
+	};
+	ASSERT_TRUE (queue.pop_batch (1024).empty ());
+
+	ASSERT_TRUE (queue.insert (make_buffer (100, 'b'), nullptr, nano::transport::traffic_type::bootstrap));
+	ASSERT_TRUE (queue.insert (make_buffer (100, 'g'), nullptr, nano::transport::traffic_type::generic));
+	ASSERT_TRUE (queue.insert (make_buffer (100, 'g'), nullptr, nano::transport::traffic_type::generic));
+	ASSERT_TRUE (queue.insert (make_buffer (500, 'g'), nullptr, nano::transport::traffic_type::generic));
+
+	// Generic traffic comes first, the batch stops before the entry that does not fit
+	auto batch1 = queue.pop_batch (300);
+	ASSERT_EQ (2, batch1.size ());
+	ASSERT_EQ ('g', batch1[0].buffer.to_bytes ()[0]);
+	ASSERT_EQ ('g', batch1[1].buffer.to_bytes ()[0]);
+
+	// An entry larger than the limit is still sent on its own
+	auto batch2 = queue.pop_batch (300);
+	ASSERT_EQ (1, batch2.size ());
+	ASSERT_EQ (500, batch2[0].buffer.size ());
+
+	auto batch3 = queue.pop_batch (300);
+	ASSERT_EQ (1, batch3.size ());
+	ASSERT_EQ ('b', batch3[0].buffer.to_bytes ()[0]);
+	ASSERT_EQ (nano::transport::traffic_type::bootstrap, batch3[0].type);
+	ASSERT_TRUE (queue.empty ());
+
+	// A batch never mixes traffic types, each is charged to its own bandwidth budget
+	ASSERT_TRUE (queue.insert (make_buffer (10, 'g'), nullptr, nano::transport::traffic_type::generic));
+	ASSERT_TRUE (queue.insert (make_buffer (10, 'b'), nullptr, nano::transport::traffic_type::bootstrap));
+	auto batch4 = queue.pop_batch (300);
+	ASSERT_EQ (1, batch4.size ());
+	ASSERT_EQ (nano::transport::traffic_type::generic, batch4[0].type);
+	auto batch5 = queue.pop_batch (300);
+	ASSERT_EQ (1, batch5.size ());
+	ASSERT_EQ (nano::transport::traffic_type::bootstrap, batch5[0].type);
+	ASSERT_TRUE (queue.empty ());
+}
+
+TEST (io_pool, round_robin)
+{
+	nano::test::system system;
+	nano::transport::io_pool pool{ 2, system.io_ctx, system.logger };
+	ASSERT_EQ (2, pool.size ());
+	auto & context1 = pool.next ();
+	auto & context2 = pool.next ();
+	ASSERT_NE (&context1, &context2);
+	ASSERT_NE (system.io_ctx.get (), &context1);
+	ASSERT_NE (system.io_ctx.get (), &context2);
+	ASSERT_EQ (&context1, &pool.next ());
+	ASSERT_EQ (&context1, pool.owner (context1).get ());
+	ASSERT_EQ (&context2, pool.owner (context2).get ());
+	pool.stop ();
+}
+
+TEST (io_pool, shared)
+{
+	nano::test::system system;
+	nano::transport::io_pool pool{ 0, system.io_ctx, system.logger };
+	ASSERT_EQ (0, pool.size ());
+	ASSERT_EQ (system.io_ctx.get (), &pool.next ());
+	ASSERT_EQ (system.io_ctx, pool.owner (pool.next ()));
+}
+
+// Sockets share ownership of their pinned context, it stays valid once the pool is gone
+TEST (io_pool, owner_outlives_pool)
+{
+	nano::test::system system;
+	std::shared_ptr<boost::asio::io_context> context;
+	{
+		nano::transport::io_pool pool{ 1, system.io_ctx, system.logger };
+		context = pool.owner (pool.next ());
+		pool.stop ();
+	}
+	ASSERT_EQ (1, context.use_count ());
+	boost::asio::ip::tcp::socket socket{ *context };
+	ASSERT_EQ (context.get (), &socket.get_executor ().context ());
+}
+
+// Nodes with sockets pinned to their own io_contexts connect and exchange messages
+TEST (io_pool, pinned_sockets)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.io_pinned_threads = 2;
+	auto & node1 = *system.add_node (config);
+	config.peering_port = system.get_available_port ();
+	auto & node2 = *system.add_node (config);
+	ASSERT_EQ (2, node1.io_pool.size ());
+	ASSERT_TIMELY (5s, node1.network.size () == 1 && node2.network.size () == 1);
+	ASSERT_TIMELY (5s, node2.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in) > 0);
+	ASSERT_TIMELY (5s, node1.stats.count (nano::stat::type::message, nano::stat::detail::keepalive, nano::stat::dir::in) > 0);
+}
+
 /**
  * Check that the socket correctly handles a tcp_io_timeout during tcp connect
  * Steps:
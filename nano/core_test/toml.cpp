@@ -154,12 +154,15 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
 	ASSERT_EQ (conf.node.active_elections.size, defaults.node.active_elections.size);
+	ASSERT_EQ (conf.node.active_elections.confirm_req_window, defaults.node.active_elections.confirm_req_window);
 	ASSERT_EQ (conf.node.allow_local_peers, defaults.node.allow_local_peers);
 	ASSERT_EQ (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_EQ (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_EQ (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
 	ASSERT_EQ (conf.node.bootstrap_bandwidth_limit, defaults.node.bootstrap_bandwidth_limit);
 	ASSERT_EQ (conf.node.bootstrap_bandwidth_burst_ratio, defaults.node.bootstrap_bandwidth_burst_ratio);
+	ASSERT_EQ (conf.node.bandwidth_shaper_quantum, defaults.node.bandwidth_shaper_quantum);
+	ASSERT_EQ (conf.node.bandwidth_shaper_interval, defaults.node.bandwidth_shaper_interval);
 	ASSERT_EQ (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_EQ (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_EQ (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
@@ -172,6 +175,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
 	ASSERT_EQ (conf.node.external_port, defaults.node.external_port);
 	ASSERT_EQ (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_EQ (conf.node.io_pinned_threads, defaults.node.io_pinned_threads);
 	ASSERT_EQ (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_EQ (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_EQ (conf.node.background_threads, defaults.node.background_threads);
@@ -192,6 +196,8 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_EQ (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_EQ (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
+	ASSERT_EQ (conf.node.vote_generator_adaptive, defaults.node.vote_generator_adaptive);
+	ASSERT_EQ (conf.node.vote_generator_threads, defaults.node.vote_generator_threads);
 	ASSERT_EQ (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_EQ (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_EQ (conf.node.work_threads, defaults.node.work_threads);
@@ -239,6 +245,7 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_EQ (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_EQ (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_EQ (conf.node.lmdb_config.compaction_interval, defaults.node.lmdb_config.compaction_interval);
 
 	ASSERT_EQ (conf.node.rocksdb_config.enable, defaults.node.rocksdb_config.enable);
 	ASSERT_EQ (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
@@ -269,6 +276,12 @@ TEST (toml, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.vote_processor.pr_priority, defaults.node.vote_processor.pr_priority);
 	ASSERT_EQ (conf.node.vote_processor.threads, defaults.node.vote_processor.threads);
 	ASSERT_EQ (conf.node.vote_processor.batch_size, defaults.node.vote_processor.batch_size);
+	ASSERT_EQ (conf.node.vote_processor.max_timestamps, defaults.node.vote_processor.max_timestamps);
+
+	ASSERT_EQ (conf.node.vote_rebroadcaster.max_queue, defaults.node.vote_rebroadcaster.max_queue);
+	ASSERT_EQ (conf.node.vote_rebroadcaster.max_rate, defaults.node.vote_rebroadcaster.max_rate);
+	ASSERT_EQ (conf.node.vote_rebroadcaster.rate_burst_ratio, defaults.node.vote_rebroadcaster.rate_burst_ratio);
+	ASSERT_EQ (conf.node.vote_rebroadcaster.max_age, defaults.node.vote_rebroadcaster.max_age);
 
 	ASSERT_EQ (conf.node.bootstrap_ascending.enable, defaults.node.bootstrap_ascending.enable);
 	ASSERT_EQ (conf.node.bootstrap_ascending.enable_database_scan, defaults.node.bootstrap_ascending.enable_database_scan);
@@ -293,6 +306,29 @@ TEST (toml, daemon_config_deserialize_defaults)
 
 	ASSERT_EQ (conf.node.message_processor.threads, defaults.node.message_processor.threads);
 	ASSERT_EQ (conf.node.message_processor.max_queue, defaults.node.message_processor.max_queue);
+	ASSERT_EQ (conf.node.message_processor.max_control_queue, defaults.node.message_processor.max_control_queue);
+	ASSERT_EQ (conf.node.message_processor.priority_publish, defaults.node.message_processor.priority_publish);
+	ASSERT_EQ (conf.node.message_processor.priority_confirm_ack, defaults.node.message_processor.priority_confirm_ack);
+	ASSERT_EQ (conf.node.message_processor.priority_confirm_req, defaults.node.message_processor.priority_confirm_req);
+	ASSERT_EQ (conf.node.message_processor.priority_bootstrap, defaults.node.message_processor.priority_bootstrap);
+	ASSERT_EQ (conf.node.message_processor.priority_control, defaults.node.message_processor.priority_control);
+	ASSERT_EQ (conf.node.message_processor.fast_vote_routing, defaults.node.message_processor.fast_vote_routing);
+
+	ASSERT_EQ (conf.node.tcp.max_inbound_connections, defaults.node.tcp.max_inbound_connections);
+	ASSERT_EQ (conf.node.tcp.max_outbound_connections, defaults.node.tcp.max_outbound_connections);
+	ASSERT_EQ (conf.node.tcp.max_attempts, defaults.node.tcp.max_attempts);
+	ASSERT_EQ (conf.node.tcp.max_attempts_per_ip, defaults.node.tcp.max_attempts_per_ip);
+	ASSERT_EQ (conf.node.tcp.connect_timeout, defaults.node.tcp.connect_timeout);
+	ASSERT_EQ (conf.node.tcp.max_write_batch_bytes, defaults.node.tcp.max_write_batch_bytes);
+
+	ASSERT_EQ (conf.node.write_queue.priority_blockprocessor, defaults.node.write_queue.priority_blockprocessor);
+	ASSERT_EQ (conf.node.write_queue.priority_confirmation_height, defaults.node.write_queue.priority_confirmation_height);
+	ASSERT_EQ (conf.node.write_queue.priority_voting_final, defaults.node.write_queue.priority_voting_final);
+	ASSERT_EQ (conf.node.write_queue.priority_node, defaults.node.write_queue.priority_node);
+	ASSERT_EQ (conf.node.write_queue.priority_generic, defaults.node.write_queue.priority_generic);
+	ASSERT_EQ (conf.node.write_queue.priority_pruning, defaults.node.write_queue.priority_pruning);
+	ASSERT_EQ (conf.node.write_queue.max_hold, defaults.node.write_queue.max_hold);
+	ASSERT_EQ (conf.node.write_queue.aging_interval, defaults.node.write_queue.aging_interval);
 }
 
 TEST (toml, optional_child)
@@ -426,6 +462,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	bandwidth_limit_burst_ratio = 999.9
 	bootstrap_bandwidth_limit = 999
 	bootstrap_bandwidth_burst_ratio = 999.9
+	bandwidth_shaper_quantum = 999
+	bandwidth_shaper_interval = 999
 	block_processor_batch_max_time = 999
 	bootstrap_connections = 999
 	bootstrap_connections_max = 999
@@ -438,6 +476,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	external_address = "0:0:0:0:0:ffff:7f01:101"
 	external_port = 999
 	io_threads = 999
+	io_pinned_threads = 999
 	lmdb_max_dbs = 999
 	network_threads = 999
 	background_threads = 999
@@ -457,6 +496,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	use_memory_pools = false
 	vote_generator_delay = 999
 	vote_generator_threshold = 9
+	vote_generator_adaptive = false
+	vote_generator_threads = 999
 	vote_minimum = "999"
 	work_peers = ["dev.org:999"]
 	work_threads = 999
@@ -485,6 +526,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	optimistic_limit_percentage = 90
 	confirmation_history_size = 999
 	confirmation_cache = 999
+	confirm_req_window = 999
 
 	[node.diagnostics.txn_tracking]
 	enable = true
@@ -564,6 +606,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	sync = "nosync_safe"
 	max_databases = 999
 	map_size = 999
+	compaction_interval = 999
 
 	[node.optimistic_scheduler]
 	enable = false
@@ -598,6 +641,13 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	pr_priority = 999
 	threads = 999
 	batch_size = 999
+	max_timestamps = 999
+
+	[node.vote_rebroadcaster]
+	max_queue = 999
+	max_rate = 999
+	rate_burst_ratio = 999.9
+	max_age = 999
 
 	[node.bootstrap_ascending]
 	enable = false
@@ -627,6 +677,31 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	[node.message_processor]
 	threads = 999
 	max_queue = 999
+	max_control_queue = 999
+	priority_publish = 999
+	priority_confirm_ack = 999
+	priority_confirm_req = 999
+	priority_bootstrap = 999
+	priority_control = 999
+	fast_vote_routing = true
+
+	[node.tcp]
+	max_inbound_connections = 999
+	max_outbound_connections = 999
+	max_attempts = 999
+	max_attempts_per_ip = 999
+	connect_timeout = 999
+	max_write_batch_bytes = 999
+
+	[node.write_queue]
+	priority_blockprocessor = 999
+	priority_confirmation_height = 999
+	priority_voting_final = 999
+	priority_node = 999
+	priority_generic = 999
+	priority_pruning = 999
+	max_hold = 999
+	aging_interval = 999
 
 	[opencl]
 	device = 999
@@ -661,12 +736,15 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
 
 	ASSERT_NE (conf.node.active_elections.size, defaults.node.active_elections.size);
+	ASSERT_NE (conf.node.active_elections.confirm_req_window, defaults.node.active_elections.confirm_req_window);
 	ASSERT_NE (conf.node.allow_local_peers, defaults.node.allow_local_peers);
 	ASSERT_NE (conf.node.backup_before_upgrade, defaults.node.backup_before_upgrade);
 	ASSERT_NE (conf.node.bandwidth_limit, defaults.node.bandwidth_limit);
 	ASSERT_NE (conf.node.bandwidth_limit_burst_ratio, defaults.node.bandwidth_limit_burst_ratio);
 	ASSERT_NE (conf.node.bootstrap_bandwidth_limit, defaults.node.bootstrap_bandwidth_limit);
 	ASSERT_NE (conf.node.bootstrap_bandwidth_burst_ratio, defaults.node.bootstrap_bandwidth_burst_ratio);
+	ASSERT_NE (conf.node.bandwidth_shaper_quantum, defaults.node.bandwidth_shaper_quantum);
+	ASSERT_NE (conf.node.bandwidth_shaper_interval, defaults.node.bandwidth_shaper_interval);
 	ASSERT_NE (conf.node.block_processor_batch_max_time, defaults.node.block_processor_batch_max_time);
 	ASSERT_NE (conf.node.bootstrap_connections, defaults.node.bootstrap_connections);
 	ASSERT_NE (conf.node.bootstrap_connections_max, defaults.node.bootstrap_connections_max);
@@ -679,6 +757,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
 	ASSERT_NE (conf.node.external_port, defaults.node.external_port);
 	ASSERT_NE (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_NE (conf.node.io_pinned_threads, defaults.node.io_pinned_threads);
 	ASSERT_NE (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_NE (conf.node.max_unchecked_blocks, defaults.node.max_unchecked_blocks);
 	ASSERT_NE (conf.node.network_threads, defaults.node.network_threads);
@@ -702,6 +781,8 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.use_memory_pools, defaults.node.use_memory_pools);
 	ASSERT_NE (conf.node.vote_generator_delay, defaults.node.vote_generator_delay);
 	ASSERT_NE (conf.node.vote_generator_threshold, defaults.node.vote_generator_threshold);
+	ASSERT_NE (conf.node.vote_generator_adaptive, defaults.node.vote_generator_adaptive);
+	ASSERT_NE (conf.node.vote_generator_threads, defaults.node.vote_generator_threads);
 	ASSERT_NE (conf.node.vote_minimum, defaults.node.vote_minimum);
 	ASSERT_NE (conf.node.work_peers, defaults.node.work_peers);
 	ASSERT_NE (conf.node.work_threads, defaults.node.work_threads);
@@ -748,6 +829,7 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.lmdb_config.sync, defaults.node.lmdb_config.sync);
 	ASSERT_NE (conf.node.lmdb_config.max_databases, defaults.node.lmdb_config.max_databases);
 	ASSERT_NE (conf.node.lmdb_config.map_size, defaults.node.lmdb_config.map_size);
+	ASSERT_NE (conf.node.lmdb_config.compaction_interval, defaults.node.lmdb_config.compaction_interval);
 
 	ASSERT_TRUE (conf.node.rocksdb_config.enable);
 	ASSERT_EQ (nano::rocksdb_config::using_rocksdb_in_tests (), defaults.node.rocksdb_config.enable);
@@ -779,6 +861,12 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.vote_processor.pr_priority, defaults.node.vote_processor.pr_priority);
 	ASSERT_NE (conf.node.vote_processor.threads, defaults.node.vote_processor.threads);
 	ASSERT_NE (conf.node.vote_processor.batch_size, defaults.node.vote_processor.batch_size);
+	ASSERT_NE (conf.node.vote_processor.max_timestamps, defaults.node.vote_processor.max_timestamps);
+
+	ASSERT_NE (conf.node.vote_rebroadcaster.max_queue, defaults.node.vote_rebroadcaster.max_queue);
+	ASSERT_NE (conf.node.vote_rebroadcaster.max_rate, defaults.node.vote_rebroadcaster.max_rate);
+	ASSERT_NE (conf.node.vote_rebroadcaster.rate_burst_ratio, defaults.node.vote_rebroadcaster.rate_burst_ratio);
+	ASSERT_NE (conf.node.vote_rebroadcaster.max_age, defaults.node.vote_rebroadcaster.max_age);
 
 	ASSERT_NE (conf.node.bootstrap_ascending.enable, defaults.node.bootstrap_ascending.enable);
 	ASSERT_NE (conf.node.bootstrap_ascending.enable_frontier_scan, defaults.node.bootstrap_ascending.enable_frontier_scan);
@@ -804,6 +892,29 @@ TEST (toml, daemon_config_deserialize_no_defaults)
 
 	ASSERT_NE (conf.node.message_processor.threads, defaults.node.message_processor.threads);
 	ASSERT_NE (conf.node.message_processor.max_queue, defaults.node.message_processor.max_queue);
+	ASSERT_NE (conf.node.message_processor.max_control_queue, defaults.node.message_processor.max_control_queue);
+	ASSERT_NE (conf.node.message_processor.priority_publish, defaults.node.message_processor.priority_publish);
+	ASSERT_NE (conf.node.message_processor.priority_confirm_ack, defaults.node.message_processor.priority_confirm_ack);
+	ASSERT_NE (conf.node.message_processor.priority_confirm_req, defaults.node.message_processor.priority_confirm_req);
+	ASSERT_NE (conf.node.message_processor.priority_bootstrap, defaults.node.message_processor.priority_bootstrap);
+	ASSERT_NE (conf.node.message_processor.priority_control, defaults.node.message_processor.priority_control);
+	ASSERT_NE (conf.node.message_processor.fast_vote_routing, defaults.node.message_processor.fast_vote_routing);
+
+	ASSERT_NE (conf.node.tcp.max_inbound_connections, defaults.node.tcp.max_inbound_connections);
+	ASSERT_NE (conf.node.tcp.max_outbound_connections, defaults.node.tcp.max_outbound_connections);
+	ASSERT_NE (conf.node.tcp.max_attempts, defaults.node.tcp.max_attempts);
+	ASSERT_NE (conf.node.tcp.max_attempts_per_ip, defaults.node.tcp.max_attempts_per_ip);
+	ASSERT_NE (conf.node.tcp.connect_timeout, defaults.node.tcp.connect_timeout);
+	ASSERT_NE (conf.node.tcp.max_write_batch_bytes, defaults.node.tcp.max_write_batch_bytes);
+
+	ASSERT_NE (conf.node.write_queue.priority_blockprocessor, defaults.node.write_queue.priority_blockprocessor);
+	ASSERT_NE (conf.node.write_queue.priority_confirmation_height, defaults.node.write_queue.priority_confirmation_height);
+	ASSERT_NE (conf.node.write_queue.priority_voting_final, defaults.node.write_queue.priority_voting_final);
+	ASSERT_NE (conf.node.write_queue.priority_node, defaults.node.write_queue.priority_node);
+	ASSERT_NE (conf.node.write_queue.priority_generic, defaults.node.write_queue.priority_generic);
+	ASSERT_NE (conf.node.write_queue.priority_pruning, defaults.node.write_queue.priority_pruning);
+	ASSERT_NE (conf.node.write_queue.max_hold, defaults.node.write_queue.max_hold);
+	ASSERT_NE (conf.node.write_queue.aging_interval, defaults.node.write_queue.aging_interval);
 }
 
 /** There should be no required values **/
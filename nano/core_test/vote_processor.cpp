@@ -326,6 +326,86 @@ TEST (vote_processor, large_votes)
 	ASSERT_TIMELY (5s, nano::test::confirmed (node, blocks));
 }
 
+/*
+ * Votes already applied to an election are dropped before being queued when rebroadcast again
+ */
+TEST (vote_processor, replay_filter)
+{
+	nano::test::system system;
+	auto node_config = system.default_config ();
+	node_config.backlog_population.enable = false;
+	auto & node = *system.add_node (node_config);
+
+	auto blocks = nano::test::setup_chain (system, node, 1, nano::dev::genesis_key, false);
+	// Genesis holds all the weight and gets a dense id once tiers are calculated
+	ASSERT_TIMELY (5s, node.rep_tiers.rep_id (nano::dev::genesis_key.pub).has_value ());
+	auto election = nano::test::start_election (system, node, blocks[0]->hash ());
+	ASSERT_NE (nullptr, election);
+
+	auto channel = std::make_shared<nano::transport::inproc::channel> (node, node);
+	auto vote = nano::test::make_vote (nano::dev::genesis_key, { blocks[0] }, nano::vote::timestamp_min * 1, 0);
+	ASSERT_TRUE (node.vote_processor.vote (vote, channel));
+	ASSERT_TIMELY_EQ (5s, 1, node.vote_timestamps.size ());
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::replay_filtered));
+
+	// The same vote is dropped without being queued
+	auto processed = node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::process);
+	ASSERT_TRUE (node.vote_processor.vote (vote, channel));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::replay_filtered));
+	ASSERT_EQ (processed, node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::process));
+
+	// A newer vote is processed
+	auto vote2 = nano::test::make_vote (nano::dev::genesis_key, { blocks[0] }, nano::vote::timestamp_min * 2, 0);
+	ASSERT_TRUE (node.vote_processor.vote (vote2, channel));
+	ASSERT_EQ (processed + 1, node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::process));
+
+	// Dropping the election forgets the timestamps so the votes are accepted by a restarted election
+	ASSERT_TIMELY_EQ (5s, node.vote_processor.size (), 0);
+	ASSERT_TRUE (node.active.erase (blocks[0]->qualified_root ()));
+	ASSERT_EQ (0, node.vote_timestamps.size ());
+	ASSERT_TRUE (node.vote_processor.vote (vote, channel));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::replay_filtered));
+}
+
+/*
+ * Each representative overwrites only its own slots, older hashes of a busy representative are no longer filtered
+ */
+TEST (vote_timestamps, slots_per_rep)
+{
+	nano::vote_timestamps timestamps{ 2 * nano::vote_timestamps::slots_per_rep };
+	nano::keypair key;
+	std::vector<nano::block_hash> hashes;
+	for (std::size_t i = 0; i <= nano::vote_timestamps::slots_per_rep; ++i)
+	{
+		hashes.push_back (nano::test::random_hash ());
+	}
+	timestamps.update (1, hashes[0], nano::vote::timestamp_min * 2);
+	ASSERT_TRUE (timestamps.replay (1, *nano::test::make_vote (key, { hashes[0] }, nano::vote::timestamp_min * 2)));
+	ASSERT_FALSE (timestamps.replay (1, *nano::test::make_vote (key, { hashes[0] }, nano::vote::timestamp_min * 3)));
+	ASSERT_FALSE (timestamps.replay (0, *nano::test::make_vote (key, { hashes[0] }, nano::vote::timestamp_min * 2)));
+
+	// Filling the slots of another representative leaves the first one untouched
+	for (std::size_t i = 1; i <= nano::vote_timestamps::slots_per_rep; ++i)
+	{
+		timestamps.update (0, hashes[i], nano::vote::timestamp_min * 2);
+	}
+	ASSERT_EQ (nano::vote_timestamps::slots_per_rep + 1, timestamps.size ());
+	ASSERT_TRUE (timestamps.replay (1, *nano::test::make_vote (key, { hashes[0] }, nano::vote::timestamp_min * 2)));
+	ASSERT_TRUE (timestamps.replay (0, *nano::test::make_vote (key, { hashes[nano::vote_timestamps::slots_per_rep] }, nano::vote::timestamp_min * 2)));
+
+	// Wrapping around overwrites the oldest slot
+	timestamps.update (0, hashes[0], nano::vote::timestamp_min * 2);
+	ASSERT_FALSE (timestamps.replay (0, *nano::test::make_vote (key, { hashes[1] }, nano::vote::timestamp_min * 2)));
+
+	// Representatives beyond the capacity are not tracked
+	timestamps.update (2, hashes[0], nano::vote::timestamp_min * 2);
+	ASSERT_FALSE (timestamps.replay (2, *nano::test::make_vote (key, { hashes[0] }, nano::vote::timestamp_min * 2)));
+
+	timestamps.erase (hashes[0]);
+	ASSERT_FALSE (timestamps.replay (1, *nano::test::make_vote (key, { hashes[0] }, nano::vote::timestamp_min * 2)));
+	ASSERT_EQ (nano::vote_timestamps::slots_per_rep - 1, timestamps.size ());
+}
+
 /**
  * basic test to check that the timestamp mask is applied correctly on vote timestamp and duration fields
  */
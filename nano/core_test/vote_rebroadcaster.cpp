@@ -0,0 +1,99 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/node/active_elections.hpp>
+#include <nano/node/vote_rebroadcaster.hpp>
+#include <nano/node/vote_router.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/vote.hpp>
+#include <nano/test_common/chains.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+/*
+ * Only votes counted by an election are rebroadcast and once a block is confirmed only the first vote for it is
+ */
+TEST (vote_rebroadcaster, confirmed)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	auto blocks = nano::test::setup_chain (system, node, 1, nano::dev::genesis_key, false);
+	auto const hash = blocks[0]->hash ();
+
+	nano::vote_rebroadcaster_config config;
+	nano::vote_rebroadcaster rebroadcaster{ config, node.ledger, node.network, node.active.recently_confirmed, node.stats };
+
+	auto vote1 = nano::test::make_vote (nano::dev::genesis_key, { hash }, nano::vote::timestamp_min * 1, 0);
+	ASSERT_FALSE (rebroadcaster.push (vote1, { { hash, nano::vote_code::indeterminate } }));
+	ASSERT_FALSE (rebroadcaster.push (vote1, { { hash, nano::vote_code::replay } }));
+	ASSERT_TRUE (rebroadcaster.push (vote1, { { hash, nano::vote_code::vote } }));
+
+	// The vote that confirmed the block is still rebroadcast
+	node.active.recently_confirmed.put (blocks[0]->qualified_root (), hash);
+	auto vote2 = nano::test::make_final_vote (nano::dev::genesis_key, { hash });
+	ASSERT_TRUE (rebroadcaster.push (vote2, { { hash, nano::vote_code::vote } }));
+
+	// Later votes for the confirmed block are redundant
+	nano::keypair key;
+	auto vote3 = nano::test::make_final_vote (key, { hash });
+	ASSERT_FALSE (rebroadcaster.push (vote3, { { hash, nano::vote_code::vote } }));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_rebroadcaster, nano::stat::detail::already_confirmed));
+	ASSERT_EQ (2, rebroadcaster.size ());
+}
+
+/*
+ * When the queue is full lower weight votes make room for higher weight ones
+ */
+TEST (vote_rebroadcaster, priority)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	auto blocks = nano::test::setup_chain (system, node, 1, nano::dev::genesis_key, false);
+	auto const hash = blocks[0]->hash ();
+
+	nano::vote_rebroadcaster_config config;
+	config.max_queue = 1;
+	nano::vote_rebroadcaster rebroadcaster{ config, node.ledger, node.network, node.active.recently_confirmed, node.stats };
+
+	nano::keypair key;
+	auto vote_low = nano::test::make_vote (key, { hash }, nano::vote::timestamp_min * 1, 0);
+	auto vote_high = nano::test::make_vote (nano::dev::genesis_key, { hash }, nano::vote::timestamp_min * 1, 0);
+
+	ASSERT_TRUE (rebroadcaster.push (vote_low, { { hash, nano::vote_code::vote } }));
+	ASSERT_TRUE (rebroadcaster.push (vote_high, { { hash, nano::vote_code::vote } }));
+	ASSERT_EQ (1, rebroadcaster.size ());
+	ASSERT_FALSE (rebroadcaster.push (vote_low, { { hash, nano::vote_code::vote } }));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_rebroadcaster, nano::stat::detail::evicted));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_rebroadcaster, nano::stat::detail::overfill));
+
+	// Final votes go before non-final ones regardless of weight
+	auto vote_final = nano::test::make_final_vote (key, { hash });
+	ASSERT_TRUE (rebroadcaster.push (vote_final, { { hash, nano::vote_code::vote } }));
+	ASSERT_EQ (1, rebroadcaster.size ());
+}
+
+/*
+ * Votes that waited in the queue longer than the configured age are dropped instead of rebroadcast
+ */
+TEST (vote_rebroadcaster, stale)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	auto blocks = nano::test::setup_chain (system, node, 1, nano::dev::genesis_key, false);
+	auto const hash = blocks[0]->hash ();
+
+	nano::vote_rebroadcaster_config config;
+	config.max_age = 10ms;
+	nano::vote_rebroadcaster rebroadcaster{ config, node.ledger, node.network, node.active.recently_confirmed, node.stats };
+
+	auto vote = nano::test::make_vote (nano::dev::genesis_key, { hash }, nano::vote::timestamp_min * 1, 0);
+	ASSERT_TRUE (rebroadcaster.push (vote, { { hash, nano::vote_code::vote } }));
+	WAIT (50ms);
+	rebroadcaster.start ();
+	ASSERT_TIMELY_EQ (5s, 1, node.stats.count (nano::stat::type::vote_rebroadcaster, nano::stat::detail::stale));
+	ASSERT_EQ (0, rebroadcaster.size ());
+	ASSERT_EQ (0, node.stats.count (nano::stat::type::vote_rebroadcaster, nano::stat::detail::rebroadcast, nano::stat::dir::out));
+	rebroadcaster.stop ();
+}
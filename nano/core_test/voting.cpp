@@ -1,9 +1,13 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/local_vote_history.hpp>
+#include <nano/node/messages.hpp>
+#include <nano/node/vote_bundling.hpp>
 #include <nano/node/vote_generator.hpp>
 #include <nano/node/vote_spacing.hpp>
 #include <nano/secure/ledger.hpp>
+#include <nano/store/component.hpp>
+#include <nano/store/final.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
 
@@ -72,6 +76,36 @@ TEST (vote_generator, cache)
 	ASSERT_TRUE (std::any_of (votes[0]->hashes.begin (), votes[0]->hashes.end (), [hash = epoch1->hash ()] (nano::block_hash const & hash_a) { return hash_a == hash; }));
 }
 
+// Generated votes are cached together with their serialized confirm_ack
+TEST (vote_generator, cache_serialized)
+{
+	nano::test::system system (1);
+	auto & node (*system.nodes[0]);
+	auto epoch1 = system.upgrade_genesis_epoch (node, nano::epoch::epoch_1);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	node.generator.add (epoch1->root (), epoch1->hash ());
+	ASSERT_TIMELY (1s, !node.history.cached (epoch1->root (), epoch1->hash ()).empty ());
+	auto cached (node.history.cached (epoch1->root (), epoch1->hash ()));
+	ASSERT_EQ (1, cached.size ());
+	ASSERT_TRUE (cached[0].confirm_ack.has_value ());
+	nano::confirm_ack message{ nano::dev::network_params.network, cached[0].vote };
+	ASSERT_EQ (message.to_shared_const_buffer ().to_bytes (), cached[0].confirm_ack->to_bytes ());
+}
+
+TEST (vote_generator, signing_threads)
+{
+	nano::test::system system;
+	nano::node_config config = system.default_config ();
+	config.vote_generator_threads = 2;
+	auto & node (*system.add_node (config));
+	auto epoch1 = system.upgrade_genesis_epoch (node, nano::epoch::epoch_1);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	node.generator.add (epoch1->root (), epoch1->hash ());
+	ASSERT_TIMELY (5s, !node.history.votes (epoch1->root (), epoch1->hash ()).empty ());
+	ASSERT_LE (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_signing_queued));
+	ASSERT_TIMELY (5s, 1 <= node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts));
+}
+
 TEST (vote_generator, multiple_representatives)
 {
 	nano::test::system system (1);
@@ -109,6 +143,84 @@ TEST (vote_generator, multiple_representatives)
 	}
 }
 
+TEST (vote_bundling_window, adapts)
+{
+	nano::vote_bundling_window bundling{ 200ms, 3, nano::network::confirm_ack_hashes_max };
+	auto now = std::chrono::steady_clock::now ();
+	// Nothing is arriving, waiting would only delay the vote
+	ASSERT_EQ (0ms, bundling.window (1, now));
+	// A steady stream of 1000 candidates per second
+	for (int i = 0; i < 2000; ++i)
+	{
+		now += 1ms;
+		bundling.arrived (1, now);
+	}
+	ASSERT_NEAR (1000.0, bundling.rate (now), 50.0);
+	// Filling a vote would take longer than the maximum delay
+	ASSERT_EQ (200ms, bundling.window (1, now));
+	// Only wait for the remaining hashes
+	auto const partial = bundling.window (nano::network::confirm_ack_hashes_max - 50, now);
+	ASSERT_GE (partial, 45ms);
+	ASSERT_LE (partial, 60ms);
+	ASSERT_EQ (0ms, bundling.window (nano::network::confirm_ack_hashes_max, now));
+	// The rate decays once candidates stop arriving
+	now += 5s;
+	ASSERT_EQ (0ms, bundling.window (1, now));
+}
+
+// With no threshold the window is bounded by the maximum delay even when nothing is arriving
+TEST (vote_bundling_window, no_rate)
+{
+	nano::vote_bundling_window bundling{ 200ms, 0, nano::network::confirm_ack_hashes_max };
+	auto now = std::chrono::steady_clock::now ();
+	ASSERT_EQ (0.0, bundling.rate (now));
+	ASSERT_EQ (200ms, bundling.window (1, now));
+	bundling.arrived (1, now);
+	now += 1h;
+	ASSERT_EQ (200ms, bundling.window (1, now));
+}
+
+TEST (vote_generator, bundle_stats)
+{
+	nano::test::system system;
+	auto & node (*system.add_node ());
+	auto epoch1 = system.upgrade_genesis_epoch (node, nano::epoch::epoch_1);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	node.generator.add (epoch1->root (), epoch1->hash ());
+	ASSERT_TIMELY (5s, 1 <= node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts));
+	// A single candidate at low load is voted for without waiting
+	ASSERT_LE (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_bundle_immediate));
+	ASSERT_FALSE (node.stats.samples (nano::stat::sample::vote_generator_bundle_size).empty ());
+}
+
+TEST (vote_generator, final_vote_commit)
+{
+	nano::test::system system;
+	auto config = system.default_config ();
+	config.backlog_population.enable = false;
+	auto & node = *system.add_node (config);
+	system.wallet (0)->insert_adhoc (nano::dev::genesis_key.prv);
+	auto send1 = nano::state_block_builder{}.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Gxrb_ratio)
+				 .link (nano::dev::genesis_key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	ASSERT_EQ (nano::block_status::progress, node.ledger.process (node.ledger.tx_begin_write (), send1));
+	node.final_generator.add (send1->root (), send1->hash ());
+	// The vote is only generated once its final vote record is committed
+	ASSERT_TIMELY (5s, !node.history.votes (send1->root (), send1->hash (), true).empty ());
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::final_vote_commit));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::final_vote_commit_records));
+	ASSERT_EQ (1, node.stats.samples (nano::stat::sample::final_vote_commit_latency).size ());
+	auto final_votes = node.ledger.store.final_vote.get (node.ledger.tx_begin_read (), send1->root ());
+	ASSERT_EQ (1, final_votes.size ());
+	ASSERT_EQ (send1->hash (), final_votes.front ());
+}
+
 TEST (vote_spacing, basic)
 {
 	nano::vote_spacing spacing{ std::chrono::milliseconds{ 100 } };
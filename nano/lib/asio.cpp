@@ -54,3 +54,18 @@ std::vector<uint8_t> nano::shared_const_buffer::to_bytes () const
 	}
 	return bytes;
 }
+
+std::string_view nano::asio_backend ()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+	return "io_uring";
+#elif defined(BOOST_ASIO_HAS_EPOLL)
+	return "epoll";
+#elif defined(BOOST_ASIO_HAS_KQUEUE)
+	return "kqueue";
+#elif defined(BOOST_ASIO_HAS_IOCP)
+	return "iocp";
+#else
+	return "select";
+#endif
+}
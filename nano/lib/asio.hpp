@@ -2,6 +2,8 @@
 
 #include <nano/boost/asio/write.hpp>
 
+#include <string_view>
+
 namespace nano
 {
 class shared_const_buffer
@@ -47,4 +49,7 @@ unsafe_async_write (AsyncWriteStream & s, BufferType && buffer, WriteHandler &&
 {
 	return boost::asio::async_write (s, buffer, std::forward<WriteHandler> (handler));
 }
+
+/** Name of the reactor asio uses for socket I/O, io_uring is selected at build time with NANO_IO_URING */
+std::string_view asio_backend ();
 }
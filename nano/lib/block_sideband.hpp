@@ -52,9 +52,17 @@ public:
 	block_sideband () = default;
 	block_sideband (nano::account const &, nano::block_hash const &, nano::amount const &, uint64_t const, nano::seconds_t const local_timestamp, nano::block_details const &, nano::epoch const source_epoch_a);
 	block_sideband (nano::account const &, nano::block_hash const &, nano::amount const &, uint64_t const, nano::seconds_t const local_timestamp, nano::epoch const epoch_a, bool const is_send, bool const is_receive, bool const is_epoch, nano::epoch const source_epoch_a);
+	/** Compact format, height and timestamp are varint encoded */
 	void serialize (nano::stream &, nano::block_type) const;
 	bool deserialize (nano::stream &, nano::block_type);
-	static size_t size (nano::block_type);
+	/** Encoded size of this sideband in the compact format */
+	size_t size (nano::block_type) const;
+	/** Upper bound of the encoded size in the compact format */
+	static size_t max_size (nano::block_type);
+	/** Fixed width format used by store versions up to v24 */
+	void serialize_v24 (nano::stream &, nano::block_type) const;
+	bool deserialize_v24 (nano::stream &, nano::block_type);
+	static size_t size_v24 (nano::block_type);
 	nano::block_hash successor{ 0 };
 	nano::account account{};
 	nano::amount balance{ 0 };
@@ -2019,7 +2019,102 @@ nano::block_sideband::block_sideband (nano::account const & account_a, nano::blo
 {
 }
 
-size_t nano::block_sideband::size (nano::block_type type_a)
+size_t nano::block_sideband::size (nano::block_type type_a) const
+{
+	size_t result (0);
+	result += sizeof (successor);
+	if (type_a != nano::block_type::state && type_a != nano::block_type::open)
+	{
+		result += sizeof (account);
+	}
+	if (type_a != nano::block_type::open)
+	{
+		result += nano::varint_size (height);
+	}
+	if (type_a == nano::block_type::receive || type_a == nano::block_type::change || type_a == nano::block_type::open)
+	{
+		result += sizeof (balance);
+	}
+	result += nano::varint_size (timestamp);
+	if (type_a == nano::block_type::state)
+	{
+		result += nano::block_details::size () + sizeof (nano::epoch);
+	}
+	return result;
+}
+
+size_t nano::block_sideband::max_size (nano::block_type type_a)
+{
+	nano::block_sideband sideband;
+	sideband.height = std::numeric_limits<uint64_t>::max ();
+	sideband.timestamp = std::numeric_limits<uint64_t>::max ();
+	return sideband.size (type_a);
+}
+
+void nano::block_sideband::serialize (nano::stream & stream_a, nano::block_type type_a) const
+{
+	// The successor must stay first and fixed width so it can be updated in place by the store
+	nano::write (stream_a, successor.bytes);
+	if (type_a != nano::block_type::state && type_a != nano::block_type::open)
+	{
+		nano::write (stream_a, account.bytes);
+	}
+	if (type_a != nano::block_type::open)
+	{
+		nano::write_varint (stream_a, height);
+	}
+	if (type_a == nano::block_type::receive || type_a == nano::block_type::change || type_a == nano::block_type::open)
+	{
+		nano::write (stream_a, balance.bytes);
+	}
+	nano::write_varint (stream_a, timestamp);
+	if (type_a == nano::block_type::state)
+	{
+		details.serialize (stream_a);
+		nano::write (stream_a, static_cast<uint8_t> (source_epoch));
+	}
+}
+
+bool nano::block_sideband::deserialize (nano::stream & stream_a, nano::block_type type_a)
+{
+	bool result (false);
+	try
+	{
+		nano::read (stream_a, successor.bytes);
+		if (type_a != nano::block_type::state && type_a != nano::block_type::open)
+		{
+			nano::read (stream_a, account.bytes);
+		}
+		if (type_a != nano::block_type::open)
+		{
+			nano::read_varint (stream_a, height);
+		}
+		else
+		{
+			height = 1;
+		}
+		if (type_a == nano::block_type::receive || type_a == nano::block_type::change || type_a == nano::block_type::open)
+		{
+			nano::read (stream_a, balance.bytes);
+		}
+		nano::read_varint (stream_a, timestamp);
+		if (type_a == nano::block_type::state)
+		{
+			result = details.deserialize (stream_a);
+			uint8_t source_epoch_uint8_t{ 0 };
+			nano::read (stream_a, source_epoch_uint8_t);
+			source_epoch = static_cast<nano::epoch> (source_epoch_uint8_t);
+		}
+	}
+	catch (std::runtime_error &)
+	{
+		result = true;
+	}
+
+	return result;
+}
+
+size_t nano::block_sideband::size_v24 (nano::block_type type_a)
 {
 	size_t result (0);
 	result += sizeof (successor);
@@ -2044,7 +2139,7 @@ size_t nano::block_sideband::size (nano::block_type type_a)
 	return result;
 }
 
-void nano::block_sideband::serialize (nano::stream & stream_a, nano::block_type type_a) const
+void nano::block_sideband::serialize_v24 (nano::stream & stream_a, nano::block_type type_a) const
 {
 	nano::write (stream_a, successor.bytes);
 	if (type_a != nano::block_type::state && type_a != nano::block_type::open)
@@ -2067,7 +2162,7 @@ void nano::block_sideband::serialize (nano::stream & stream_a, nano::block_type
 	}
 }
 
-bool nano::block_sideband::deserialize (nano::stream & stream_a, nano::block_type type_a)
+bool nano::block_sideband::deserialize_v24 (nano::stream & stream_a, nano::block_type type_a)
 {
 	bool result (false);
 	try
@@ -26,6 +26,7 @@ nano::error nano::lmdb_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("sync", sync_string, "Sync strategy for flushing commits to the ledger database. This does not affect the wallet database.\ntype:string,{always, nosync_safe, nosync_unsafe, nosync_unsafe_large_memory}");
 	toml.put ("max_databases", max_databases, "Maximum open lmdb databases. Increase default if more than 100 wallets is required.\nNote: external management is recommended when a large amounts of wallets are required (see https://docs.nano.org/integration-guides/key-management/).\ntype:uin32");
 	toml.put ("map_size", map_size, "Maximum ledger database map size in bytes.\ntype:uint64");
+	toml.put ("compaction_interval", compaction_interval.count (), "Interval between online compactions of the ledger database, reclaiming space freed by pruning. Writes made while the database is copied are replayed onto the copy before it replaces the database. 0 disables compaction.\ntype:hours");
 	return toml.get_error ();
 }
 
@@ -35,6 +36,10 @@ nano::error nano::lmdb_config::deserialize_toml (nano::tomlconfig & toml)
 	toml.get_optional<uint32_t> ("max_databases", max_databases);
 	toml.get_optional<size_t> ("map_size", map_size);
 
+	auto compaction_interval_l = compaction_interval.count ();
+	toml.get_optional ("compaction_interval", compaction_interval_l);
+	compaction_interval = std::chrono::hours{ compaction_interval_l };
+
 	if (!toml.get_error ())
 	{
 		std::string sync_string = "always";
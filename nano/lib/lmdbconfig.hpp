@@ -2,6 +2,7 @@
 
 #include <nano/lib/errors.hpp>
 
+#include <chrono>
 #include <thread>
 
 namespace nano
@@ -46,5 +47,7 @@ public:
 	sync_strategy sync{ always };
 	uint32_t max_databases{ 128 };
 	size_t map_size{ 256ULL * 1024 * 1024 * 1024 };
+	/** Interval between online compactions of the ledger database, zero disables them */
+	std::chrono::hours compaction_interval{ 0 };
 };
 }
@@ -39,6 +39,9 @@ public:
 	/** Returns the largest burst observed */
 	std::size_t largest_burst () const;
 
+	/** Maximum number of tokens that can be consumed at once */
+	std::size_t capacity () const;
+
 	/** Update the max_token_count and/or refill_rate_a parameters */
 	void reset (std::size_t max_token_count, std::size_t refill_rate);
 
@@ -68,6 +71,8 @@ public:
 
 	bool should_pass (std::size_t buffer_size);
 	void reset (std::size_t limit, double burst_ratio = 1.0);
+	/** Largest buffer size that can ever pass */
+	std::size_t capacity () const;
 
 private:
 	nano::rate::token_bucket bucket;
@@ -88,6 +88,7 @@ enum class type
 	handshake,
 	rep_crawler,
 	local_block_broadcaster,
+	vote_rebroadcaster,
 	rep_tiers,
 	syn_cookies,
 	peer_history,
@@ -95,6 +96,12 @@ enum class type
 	message_processor,
 	message_processor_overfill,
 	message_processor_type,
+	message_processor_latency,
+	write_queue,
+	write_queue_wait,
+	write_queue_hold,
+	buffer_pool,
+	bandwidth_shaper,
 
 	_last // Must be the last enum
 };
@@ -143,6 +150,9 @@ enum class detail
 	overfill,
 	batch,
 
+	// message_processor
+	fast_route,
+
 	// error specific
 	insufficient_work,
 	http_callback,
@@ -233,6 +243,7 @@ enum class detail
 	// vote processor
 	vote_overflow,
 	vote_ignored,
+	replay_filtered,
 
 	// election specific
 	vote_new,
@@ -293,6 +304,18 @@ enum class detail
 	tcp_connect_error,
 	tcp_read_error,
 	tcp_write_error,
+	tcp_write_batch,
+	tcp_write_coalesced,
+
+	// buffer_pool
+	allocate,
+	reuse,
+	discard,
+
+	// bandwidth_shaper
+	granted,
+	queued,
+	resumed,
 
 	// tcp_listener
 	accept_success,
@@ -355,6 +378,8 @@ enum class detail
 	// request_aggregator
 	request_hashes,
 	overfill_hashes,
+	batch_hashes,
+	batch_hashes_unique,
 	normal_vote,
 	final_vote,
 
@@ -378,6 +403,17 @@ enum class detail
 	generator_replies,
 	generator_replies_discarded,
 	generator_spacing,
+	generator_signatures_saved,
+	generator_signing_queued,
+	generator_signing_wait,
+	generator_bundle_waited,
+	generator_bundle_immediate,
+	final_vote_commit,
+	final_vote_commit_records,
+
+	// vote rebroadcaster
+	evicted,
+	stale,
 
 	// hinting
 	missing_block,
@@ -544,6 +580,15 @@ enum class detail
 	blocks_by_account,
 	account_info_by_hash,
 
+	// write_queue
+	generic,
+	node,
+	blockprocessor,
+	confirmation_height,
+	pruning,
+	voting_final,
+	testing,
+
 	_last // Must be the last enum
 };
 
@@ -563,6 +608,12 @@ enum class sample
 	active_election_duration,
 	bootstrap_tag_duration,
 	rep_response_time,
+	write_queue_wait,
+	write_queue_hold,
+	message_processor_latency,
+	vote_generator_bundle_size,
+	vote_generator_bundle_wait,
+	final_vote_commit_latency,
 
 	_last // Must be the last enum
 };
@@ -8,6 +8,7 @@
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/stream_buffer.hpp>
 
+#include <limits>
 #include <streambuf>
 #include <string>
 #include <vector>
@@ -87,4 +88,56 @@ void read_big_endian (nano::stream & stream, T & value)
 	nano::read (stream, tmp);
 	value = boost::endian::big_to_native (tmp);
 }
+
+/*
+ * Unsigned LEB128 encoding, 7 bits per byte with the high bit set on every byte except the last
+ * Used where small values dominate and a fixed width would waste space
+ */
+template <typename T>
+void write_varint (nano::stream & stream, T value)
+{
+	static_assert (std::is_unsigned<T>::value, "Varint encoding requires an unsigned type");
+	while (value >= 0x80)
+	{
+		nano::write (stream, static_cast<uint8_t> (value | 0x80));
+		value >>= 7;
+	}
+	nano::write (stream, static_cast<uint8_t> (value));
+}
+
+// Throws if the stream ends early or the encoded value does not fit in `T'
+template <typename T>
+void read_varint (nano::stream & stream, T & value)
+{
+	static_assert (std::is_unsigned<T>::value, "Varint encoding requires an unsigned type");
+	T result{ 0 };
+	for (unsigned shift = 0;; shift += 7)
+	{
+		uint8_t byte;
+		nano::read (stream, byte);
+		if (shift >= std::numeric_limits<T>::digits || (shift > 0 && (static_cast<T> (byte & 0x7f) >> (std::numeric_limits<T>::digits - shift)) != 0))
+		{
+			throw std::runtime_error ("Varint overflow");
+		}
+		result |= static_cast<T> (byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			break;
+		}
+	}
+	value = result;
+}
+
+template <typename T>
+constexpr size_t varint_size (T value)
+{
+	static_assert (std::is_unsigned<T>::value, "Varint encoding requires an unsigned type");
+	size_t result = 1;
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		++result;
+	}
+	return result;
+}
 }
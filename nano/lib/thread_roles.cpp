@@ -22,6 +22,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::io_daemon:
 			thread_role_name_string = "I/O (daemon)";
 			break;
+		case nano::thread_role::name::io_pinned:
+			thread_role_name_string = "I/O (pinned)";
+			break;
 		case nano::thread_role::name::work:
 			thread_role_name_string = "Work pool";
 			break;
@@ -133,6 +136,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::local_block_broadcasting:
 			thread_role_name_string = "Local broadcast";
 			break;
+		case nano::thread_role::name::vote_rebroadcasting:
+			thread_role_name_string = "Vote rebroadcast";
+			break;
 		case nano::thread_role::name::rep_tiers:
 			thread_role_name_string = "Rep tiers";
 			break;
@@ -163,6 +169,15 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::monitor:
 			thread_role_name_string = "Monitor";
 			break;
+		case nano::thread_role::name::bandwidth_shaper:
+			thread_role_name_string = "Outbound shaper";
+			break;
+		case nano::thread_role::name::vote_signing:
+			thread_role_name_string = "Vote signing";
+			break;
+		case nano::thread_role::name::ledger_compaction:
+			thread_role_name_string = "Ledger compact";
+			break;
 		default:
 			debug_assert (false && "nano::thread_role::get_string unhandled thread role");
 	}
@@ -12,6 +12,7 @@ enum class name
 	unknown,
 	io,
 	io_daemon,
+	io_pinned,
 	work,
 	message_processing,
 	vote_processing,
@@ -50,6 +51,7 @@ enum class name
 	scheduler_priority,
 	rep_crawler,
 	local_block_broadcasting,
+	vote_rebroadcasting,
 	rep_tiers,
 	network_cleanup,
 	network_keepalive,
@@ -61,6 +63,9 @@ enum class name
 	stats,
 	vote_router,
 	monitor,
+	bandwidth_shaper,
+	vote_signing,
+	ledger_compaction,
 };
 
 std::string_view to_string (name);
@@ -124,7 +124,7 @@ int main (int argc, char * const * argv)
 		("debug_verify_profile", "Profile signature verification")
 		("debug_verify_profile_batch", "Profile batch signature verification")
 		("debug_profile_bootstrap", "Profile bootstrap style blocks processing (at least 10GB of free storage space required)")
-		("debug_profile_sign", "Profile signature generation")
+		("debug_profile_sign", "Profile signature generation, optionally using multiple --threads")
 		("debug_profile_process", "Profile active blocks processing (only for nano_dev_network)")
 		("debug_profile_votes", "Profile votes processing (only for nano_dev_network)")
 		("debug_profile_frontiers_confirmation", "Profile frontiers confirmation speed (only for nano_dev_network)")
@@ -910,27 +910,50 @@ int main (int argc, char * const * argv)
 		}
 		else if (vm.count ("debug_profile_sign"))
 		{
-			std::cerr << "Starting blocks signing profiling\n";
+			unsigned threads_count (1);
+			auto threads_it = vm.find ("threads");
+			if (threads_it != vm.end ())
+			{
+				if (!boost::conversion::try_lexical_convert (threads_it->second.as<std::string> (), threads_count) || threads_count == 0)
+				{
+					std::cerr << "Invalid threads count\n";
+					return -1;
+				}
+			}
+			std::cerr << boost::str (boost::format ("Starting blocks signing profiling with %1% threads\n") % threads_count);
+			uint64_t const signatures_per_thread (1000);
 			while (true)
 			{
-				nano::keypair key;
-				nano::block_builder builder;
-				nano::block_hash latest (0);
 				auto begin1 (std::chrono::high_resolution_clock::now ());
-				for (uint64_t balance (0); balance < 1000; ++balance)
+				std::vector<std::thread> threads;
+				for (unsigned thread (0); thread < threads_count; ++thread)
 				{
-					auto send = builder
-								.send ()
-								.previous (latest)
-								.destination (key.pub)
-								.balance (balance)
-								.sign (key.prv, key.pub)
-								.work (0)
-								.build ();
-					latest = send->hash ();
+					threads.emplace_back ([signatures_per_thread] () {
+						nano::keypair key;
+						nano::block_builder builder;
+						nano::block_hash latest (0);
+						for (uint64_t balance (0); balance < signatures_per_thread; ++balance)
+						{
+							auto send = builder
+										.send ()
+										.previous (latest)
+										.destination (key.pub)
+										.balance (balance)
+										.sign (key.prv, key.pub)
+										.work (0)
+										.build ();
+							latest = send->hash ();
+						}
+					});
+				}
+				for (auto & thread : threads)
+				{
+					thread.join ();
 				}
 				auto end1 (std::chrono::high_resolution_clock::now ());
-				std::cerr << boost::str (boost::format ("%|1$ 12d|\n") % std::chrono::duration_cast<std::chrono::microseconds> (end1 - begin1).count ());
+				auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (end1 - begin1).count ());
+				// Elapsed time for every thread to sign its share, followed by the combined signatures per second
+				std::cerr << boost::str (boost::format ("%|1$ 12d| %|2$ 12d|/s\n") % elapsed % (signatures_per_thread * threads_count * 1000000 / std::max<int64_t> (elapsed, 1)));
 			}
 		}
 		else if (vm.count ("debug_profile_process"))
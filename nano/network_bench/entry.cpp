@@ -0,0 +1,445 @@
+#include <nano/lib/block_sideband.hpp>
+#include <nano/lib/block_type.hpp>
+#include <nano/lib/blockbuilders.hpp>
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/node/blockprocessor.hpp>
+#include <nano/node/messages.hpp>
+#include <nano/node/network.hpp>
+#include <nano/node/node_observers.hpp>
+#include <nano/node/transport/fake.hpp>
+#include <nano/secure/vote.hpp>
+#include <nano/store/block.hpp>
+#include <nano/store/component.hpp>
+#include <nano/test_common/chains.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <thread>
+#include <unordered_map>
+
+namespace nano
+{
+namespace test
+{
+	void cleanup_dev_directories_on_exit ();
+}
+void force_nano_dev_network ();
+}
+
+namespace
+{
+// Counts heap allocations made by the whole process while messages are in flight
+std::atomic<uint64_t> allocations{ 0 };
+// Counts heap allocations made by the current thread, excludes background node threads from single threaded measurements
+thread_local uint64_t thread_allocations{ 0 };
+}
+
+void * operator new (std::size_t size)
+{
+	allocations.fetch_add (1, std::memory_order_relaxed);
+	++thread_allocations;
+	if (auto result = std::malloc (size == 0 ? 1 : size))
+	{
+		return result;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete (void * pointer) noexcept
+{
+	std::free (pointer);
+}
+
+void operator delete (void * pointer, std::size_t) noexcept
+{
+	std::free (pointer);
+}
+
+namespace
+{
+/*
+ * Send times indexed by message number and the latencies observed by receiving nodes
+ */
+class tracker
+{
+public:
+	explicit tracker (size_t count) :
+		sent (count)
+	{
+		latencies.reserve (count);
+	}
+
+	void sending (size_t index)
+	{
+		auto const now = std::chrono::steady_clock::now ();
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		sent[index] = now;
+	}
+
+	void received (size_t index)
+	{
+		auto const now = std::chrono::steady_clock::now ();
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		latencies.push_back (std::chrono::duration_cast<std::chrono::microseconds> (now - sent[index]));
+	}
+
+	size_t size () const
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		return latencies.size ();
+	}
+
+	std::vector<std::chrono::steady_clock::time_point> sent;
+
+	mutable nano::mutex mutex;
+	std::vector<std::chrono::microseconds> latencies;
+};
+
+std::chrono::microseconds percentile (std::vector<std::chrono::microseconds> const & sorted, double fraction)
+{
+	if (sorted.empty ())
+	{
+		return {};
+	}
+	auto index = std::min (sorted.size () - 1, static_cast<size_t> (fraction * sorted.size ()));
+	return sorted[index];
+}
+
+std::vector<std::unique_ptr<nano::message>> make_publish (nano::test::system & system, size_t count, std::unordered_map<nano::block_hash, size_t> & index)
+{
+	std::vector<std::unique_ptr<nano::message>> result;
+	result.reserve (count);
+	nano::state_block_builder builder;
+	for (size_t n = 0; n < count; ++n)
+	{
+		// Blocks only need to be unique and carry valid work, they are not expected to be accepted by the ledger
+		nano::block_hash previous{ n + 1 };
+		auto block = builder.make_block ()
+					 .account (nano::dev::genesis_key.pub)
+					 .previous (previous)
+					 .representative (nano::dev::genesis_key.pub)
+					 .link (0)
+					 .balance (nano::dev::constants.genesis_amount - 1)
+					 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					 .work (*system.work.generate (previous))
+					 .build ();
+		index.emplace (block->hash (), n);
+		result.push_back (std::make_unique<nano::publish> (nano::dev::network_params.network, block));
+	}
+	return result;
+}
+
+std::vector<std::unique_ptr<nano::message>> make_confirm_ack (size_t count)
+{
+	std::vector<std::unique_ptr<nano::message>> result;
+	result.reserve (count);
+	for (size_t n = 0; n < count; ++n)
+	{
+		// The voted hash encodes the message number
+		auto vote = nano::test::make_vote (nano::dev::genesis_key, { nano::block_hash{ n + 1 } });
+		result.push_back (std::make_unique<nano::confirm_ack> (nano::dev::network_params.network, vote));
+	}
+	return result;
+}
+
+struct flood_result
+{
+	double allocations_per_flood;
+	std::chrono::nanoseconds time_per_flood;
+};
+
+template <typename Func>
+flood_result measure_flood (size_t iterations, Func && flood)
+{
+	auto const allocations_start = thread_allocations;
+	auto const start = std::chrono::steady_clock::now ();
+	for (size_t n = 0; n < iterations; ++n)
+	{
+		flood ();
+	}
+	auto const elapsed = std::chrono::steady_clock::now () - start;
+	return { static_cast<double> (thread_allocations - allocations_start) / iterations, std::chrono::duration_cast<std::chrono::nanoseconds> (elapsed / iterations) };
+}
+
+/*
+ * Compares flooding a full confirm_ack to many channels when the message is serialized for each channel
+ * against serializing it once and sharing the buffer, which is what nano::network::flood_* does
+ */
+int flood_serialize (nano::test::system & system, size_t channel_count, size_t iterations)
+{
+	auto & node = *system.add_node ();
+
+	std::vector<std::shared_ptr<nano::transport::channel>> channels;
+	for (size_t n = 0; n < channel_count; ++n)
+	{
+		channels.push_back (std::make_shared<nano::transport::fake::channel> (node));
+	}
+
+	std::vector<nano::block_hash> hashes;
+	for (size_t n = 0; n < nano::network::confirm_ack_hashes_max; ++n)
+	{
+		hashes.push_back (nano::block_hash{ n + 1 });
+	}
+	auto vote = nano::test::make_vote (nano::dev::genesis_key, hashes);
+	nano::confirm_ack message{ nano::dev::network_params.network, vote };
+
+	auto per_channel = measure_flood (iterations, [&] () {
+		for (auto const & channel : channels)
+		{
+			channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		}
+	});
+
+	auto shared = measure_flood (iterations, [&] () {
+		auto const buffer = message.to_shared_const_buffer ();
+		for (auto const & channel : channels)
+		{
+			channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		}
+	});
+
+	std::cout << "channels: " << channel_count << ", message size: " << message.to_shared_const_buffer ().size () << " bytes" << std::endl;
+	std::cout << "serialize per channel: " << per_channel.allocations_per_flood << " allocations, " << per_channel.time_per_flood.count () << " ns per flood" << std::endl;
+	std::cout << "serialize once: " << shared.allocations_per_flood << " allocations, " << shared.time_per_flood.count () << " ns per flood" << std::endl;
+
+	return shared.allocations_per_flood < per_channel.allocations_per_flood ? 0 : 2;
+}
+
+/*
+ * Generates a ledger and reports the bytes taken by its block entries with the fixed width sideband used up to store version v24
+ * and the compact sideband written since v25, both are serialized from the same stored blocks
+ */
+int sideband_size (nano::test::system & system, int chain_count, int chain_length)
+{
+	auto config = system.default_config ();
+	config.backlog_population.enable = false;
+	auto & node = *system.add_node (config);
+	std::cout << "Generating " << chain_count << " chains of " << chain_length << " blocks" << std::endl;
+	nano::test::setup_chains (system, node, chain_count, chain_length, nano::dev::genesis_key, false);
+
+	struct totals
+	{
+		uint64_t count{ 0 };
+		uint64_t size_v24{ 0 };
+		uint64_t size_v25{ 0 };
+	};
+	std::map<nano::block_type, totals> by_type;
+	totals all;
+	auto transaction = node.store.tx_begin_read ();
+	for (auto it = node.store.block.begin (transaction), end = node.store.block.end (); it != end; ++it)
+	{
+		auto const & [block, sideband] = it->second;
+		auto const type = block->type ();
+		auto const body = sizeof (nano::block_type) + nano::block::size (type);
+		std::vector<uint8_t> v24;
+		std::vector<uint8_t> v25;
+		{
+			nano::vectorstream stream (v24);
+			sideband.serialize_v24 (stream, type);
+		}
+		{
+			nano::vectorstream stream (v25);
+			sideband.serialize (stream, type);
+		}
+		for (auto * entry : { &by_type[type], &all })
+		{
+			++entry->count;
+			entry->size_v24 += body + v24.size ();
+			entry->size_v25 += body + v25.size ();
+		}
+	}
+
+	std::cout << std::fixed << std::setprecision (2);
+	auto print = [] (std::string_view name, totals const & entry) {
+		std::cout << name << ": " << entry.count << " entries, v24: " << entry.size_v24 << " bytes (" << static_cast<double> (entry.size_v24) / entry.count << " per entry), v25: " << entry.size_v25 << " bytes (" << static_cast<double> (entry.size_v25) / entry.count << " per entry)" << std::endl;
+	};
+	for (auto const & [type, entry] : by_type)
+	{
+		print (nano::to_string (type), entry);
+	}
+	print ("total", all);
+	std::cout << "reduction: " << (100.0 - 100.0 * all.size_v25 / std::max<uint64_t> (all.size_v24, 1)) << " %" << std::endl;
+
+	return all.size_v25 < all.size_v24 ? 0 : 2;
+}
+}
+
+/*
+ * Floods publish or confirm_ack messages from one node to its peers over loopback and reports throughput,
+ * wire to processing latency, drops and allocations. Intended for tracking regressions in the network stack.
+ */
+int main (int argc, char * const * argv)
+{
+	nano::initialize_file_descriptor_limit ();
+	nano::logger::initialize_for_tests (nano::log_config::tests_default ());
+	nano::force_nano_dev_network ();
+	nano::node_singleton_memory_pool_purge_guard memory_pool_cleanup_guard;
+
+	boost::program_options::options_description description ("Command line options");
+
+	// clang-format off
+	description.add_options ()
+		("help", "Print out options")
+		("node_count,n", boost::program_options::value<size_t> ()->default_value (2), "The number of in-process nodes, the first one sends to all others")
+		("message_count,m", boost::program_options::value<size_t> ()->default_value (100000), "How many messages to send")
+		("message_type,t", boost::program_options::value<std::string> ()->default_value ("confirm_ack"), "Message type to send, confirm_ack or publish")
+		("rate,r", boost::program_options::value<size_t> ()->default_value (0), "Messages per second to send, 0 for as fast as possible")
+		("timeout", boost::program_options::value<size_t> ()->default_value (30), "Seconds to wait for outstanding messages after sending")
+		("fast_vote_routing", "Route votes directly to the vote processor")
+		("flood_serialize", "Compare allocations per flood when serializing per channel and once per flood instead of sending between nodes")
+		("channel_count", boost::program_options::value<size_t> ()->default_value (32), "How many channels to flood to with flood_serialize")
+		("sideband_size", "Generate a ledger and compare the size of block entries with the v24 and v25 sideband formats instead of sending between nodes")
+		("chain_count", boost::program_options::value<int> ()->default_value (1000), "How many account chains to generate with sideband_size")
+		("chain_length", boost::program_options::value<int> ()->default_value (20), "How many blocks to generate for each account chain with sideband_size");
+	// clang-format on
+
+	boost::program_options::variables_map vm;
+	try
+	{
+		boost::program_options::store (boost::program_options::parse_command_line (argc, argv, description), vm);
+	}
+	catch (boost::program_options::error const & err)
+	{
+		std::cerr << err.what () << std::endl;
+		return 1;
+	}
+	boost::program_options::notify (vm);
+	if (vm.count ("help"))
+	{
+		std::cout << description << std::endl;
+		return 0;
+	}
+
+	auto const node_count = std::max<size_t> (vm["node_count"].as<size_t> (), 2);
+	auto const message_count = vm["message_count"].as<size_t> ();
+	auto const message_type = vm["message_type"].as<std::string> ();
+	auto const rate = vm["rate"].as<size_t> ();
+	auto const timeout = std::chrono::seconds{ vm["timeout"].as<size_t> () };
+	if (message_type != "confirm_ack" && message_type != "publish")
+	{
+		std::cerr << "Unknown message type: " << message_type << std::endl;
+		return 1;
+	}
+
+	int result = 0;
+	if (vm.count ("flood_serialize"))
+	{
+		nano::test::system system;
+		result = flood_serialize (system, vm["channel_count"].as<size_t> (), std::max<size_t> (message_count / 10, 1));
+	}
+	else if (vm.count ("sideband_size"))
+	{
+		nano::test::system system;
+		result = sideband_size (system, vm["chain_count"].as<int> (), vm["chain_length"].as<int> ());
+	}
+	else
+	{
+		nano::test::system system;
+		for (size_t n = 0; n < node_count; ++n)
+		{
+			auto config = system.default_config ();
+			config.message_processor.fast_vote_routing = vm.count ("fast_vote_routing") > 0;
+			system.add_node (config);
+		}
+		auto & sender = *system.nodes[0];
+
+		std::cout << "Generating " << message_count << " " << message_type << " messages" << std::endl;
+		std::unordered_map<nano::block_hash, size_t> block_index;
+		auto messages = message_type == "publish" ? make_publish (system, message_count, block_index) : make_confirm_ack (message_count);
+
+		tracker track{ message_count };
+		for (size_t n = 1; n < node_count; ++n)
+		{
+			auto & receiver = *system.nodes[n];
+			receiver.observers.vote.add ([&track, message_count] (std::shared_ptr<nano::vote> const & vote, auto const &, auto, auto) {
+				auto const index = vote->hashes.front ().number () - 1;
+				if (index < message_count)
+				{
+					track.received (static_cast<size_t> (index));
+				}
+			});
+			receiver.block_processor.block_processed.add ([&track, &block_index] (auto const &, nano::block_processor::context const & context) {
+				if (auto existing = block_index.find (context.block->hash ()); existing != block_index.end ())
+				{
+					track.received (existing->second);
+				}
+			});
+		}
+
+		auto channels = sender.network.list (node_count);
+		std::cout << "Sending to " << channels.size () << " peers" << std::endl;
+		auto const expected = message_count * channels.size ();
+
+		auto const allocations_start = allocations.load ();
+		auto const start = std::chrono::steady_clock::now ();
+		for (size_t n = 0; n < message_count; ++n)
+		{
+			if (rate > 0)
+			{
+				std::this_thread::sleep_until (start + std::chrono::microseconds{ n * 1000000 / rate });
+			}
+			auto const & message = *messages[n];
+			auto const buffer = message.to_shared_const_buffer ();
+			track.sending (n);
+			for (auto const & channel : channels)
+			{
+				channel->send (message, buffer);
+			}
+		}
+		auto const sent = std::chrono::steady_clock::now ();
+
+		// Wait until everything arrived or nothing arrived for the timeout
+		auto last_progress = std::chrono::steady_clock::now ();
+		auto last_received = track.size ();
+		while (last_received < expected && std::chrono::steady_clock::now () - last_progress < timeout)
+		{
+			std::this_thread::sleep_for (std::chrono::milliseconds{ 10 });
+			if (auto received = track.size (); received != last_received)
+			{
+				last_received = received;
+				last_progress = std::chrono::steady_clock::now ();
+			}
+		}
+		auto const done = std::chrono::steady_clock::now ();
+		auto const allocations_total = allocations.load () - allocations_start;
+
+		std::vector<std::chrono::microseconds> latencies;
+		{
+			nano::lock_guard<nano::mutex> guard{ track.mutex };
+			latencies = track.latencies;
+		}
+		std::sort (latencies.begin (), latencies.end ());
+
+		auto const to_ms = [] (auto duration) { return std::chrono::duration_cast<std::chrono::duration<double, std::milli>> (duration).count (); };
+		auto const elapsed = std::max (to_ms (done - start), 1.0);
+
+		uint64_t dropped = 0;
+		for (auto const & node : system.nodes)
+		{
+			dropped += node->stats.count (nano::stat::type::drop, nano::stat::dir::in);
+			dropped += node->stats.count (nano::stat::type::drop, nano::stat::dir::out);
+		}
+
+		std::cout << std::fixed << std::setprecision (2);
+		std::cout << "sent: " << message_count * channels.size () << " in " << to_ms (sent - start) << " ms" << std::endl;
+		std::cout << "received: " << latencies.size () << " in " << elapsed << " ms (" << (latencies.size () * 1000.0 / elapsed) << " messages/s)" << std::endl;
+		std::cout << "lost: " << (expected - std::min (expected, latencies.size ())) << ", dropped (stats): " << dropped << std::endl;
+		std::cout << "latency p50: " << percentile (latencies, 0.50).count () << " us, p99: " << percentile (latencies, 0.99).count () << " us, max: " << (latencies.empty () ? 0 : latencies.back ().count ()) << " us" << std::endl;
+		std::cout << "allocations: " << (static_cast<double> (allocations_total) / std::max<size_t> (expected, 1)) << " per message" << std::endl;
+
+		result = latencies.size () == expected ? 0 : 2;
+	}
+	nano::test::cleanup_dev_directories_on_exit ();
+	return result;
+}
@@ -11,6 +11,7 @@
 #include <nano/node/scheduler/component.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/node/vote_router.hpp>
+#include <nano/node/vote_timestamps.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/component.hpp>
@@ -26,7 +27,8 @@ nano::active_elections::active_elections (nano::node & node_a, nano::confirming_
 	block_processor{ block_processor_a },
 	recently_confirmed{ config.confirmation_cache },
 	recently_cemented{ config.confirmation_history_size },
-	election_time_to_live{ node_a.network_params.network.is_dev_network () ? 0s : 2s }
+	election_time_to_live{ node_a.network_params.network.is_dev_network () ? 0s : 2s },
+	solicitor{ std::make_unique<nano::confirmation_solicitor> (node_a.network, node_a.online_reps, node_a.config) }
 {
 	count_by_behavior.fill (0); // Zero initialize array
 
@@ -280,7 +282,7 @@ void nano::active_elections::request_confirm (nano::unique_lock<nano::mutex> & l
 
 	lock_a.unlock ();
 
-	nano::confirmation_solicitor solicitor (node.network, node.config);
+	auto & solicitor = *this->solicitor;
 	solicitor.prepare (node.rep_crawler.principal_representatives (std::numeric_limits<std::size_t>::max ()));
 
 	std::size_t unconfirmed_count_l (0);
@@ -364,6 +366,8 @@ void nano::active_elections::cleanup_election (nano::unique_lock<nano::mutex> &
 		{
 			// Clear from publish filter
 			node.network.filter.clear (block);
+			// Votes for the block should be accepted again if the election is restarted
+			node.vote_timestamps.erase (hash);
 		}
 	}
 }
@@ -610,7 +614,9 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (ac
  * active_elections_config
  */
 
-nano::active_elections_config::active_elections_config (const nano::network_constants & network_constants)
+nano::active_elections_config::active_elections_config (const nano::network_constants & network_constants) :
+	// Requests are sent right away on the dev network to keep tests deterministic
+	confirm_req_window{ network_constants.is_dev_network () ? 0 : network_constants.aec_loop_interval_ms }
 {
 }
 
@@ -621,6 +627,7 @@ nano::error nano::active_elections_config::serialize (nano::tomlconfig & toml) c
 	toml.put ("optimistic_limit_percentage", optimistic_limit_percentage, "Limit of optimistic elections as percentage of `active_elections_size`. \ntype:uint64");
 	toml.put ("confirmation_history_size", confirmation_history_size, "Maximum confirmation history size. If tracking the rate of block confirmations, the websocket feature is recommended instead. \ntype:uint64");
 	toml.put ("confirmation_cache", confirmation_cache, "Maximum number of confirmed elections kept in cache to prevent restarting an election. \ntype:uint64");
+	toml.put ("confirm_req_window", confirm_req_window.count (), "Maximum time confirmation requests that do not fill a whole message are held back, to be bundled with requests from later iterations. \ntype:milliseconds");
 
 	return toml.get_error ();
 }
@@ -633,6 +640,10 @@ nano::error nano::active_elections_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("confirmation_history_size", confirmation_history_size);
 	toml.get ("confirmation_cache", confirmation_cache);
 
+	auto confirm_req_window_l = confirm_req_window.count ();
+	toml.get ("confirm_req_window", confirm_req_window_l);
+	confirm_req_window = std::chrono::milliseconds{ confirm_req_window_l };
+
 	return toml.get_error ();
 }
 
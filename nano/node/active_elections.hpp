@@ -32,6 +32,7 @@ class active_elections;
 class block;
 class block_sideband;
 class block_processor;
+class confirmation_solicitor;
 class confirming_set;
 class election;
 class vote;
@@ -66,6 +67,8 @@ public:
 	std::size_t confirmation_cache{ 65536 };
 	// Maximum size of election winner details set
 	std::size_t max_election_winners{ 1024 * 16 };
+	// Maximum time partially filled confirmation requests are held back to be filled by later request loop iterations
+	std::chrono::milliseconds confirm_req_window;
 };
 
 /**
@@ -181,6 +184,9 @@ private:
 	/** Keeps track of number of elections by election behavior (normal, hinted, optimistic) */
 	nano::enum_array<nano::election_behavior, int64_t> count_by_behavior{};
 
+	/** Only used by the request loop thread, keeps requests to representatives across iterations */
+	std::unique_ptr<nano::confirmation_solicitor> solicitor;
+
 	nano::condition_variable condition;
 	bool stopped{ false };
 	std::thread thread;
@@ -1,3 +1,5 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/thread_roles.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/bandwidth_limiter.hpp>
 #include <nano/node/nodeconfig.hpp>
@@ -6,13 +8,50 @@
  * bandwidth_limiter
  */
 
-nano::bandwidth_limiter::bandwidth_limiter (nano::node_config const & node_config_a) :
+nano::bandwidth_limiter::bandwidth_limiter (nano::node_config const & node_config_a, nano::stats & stats_a) :
 	config{ node_config_a },
+	stats{ stats_a },
 	limiter_generic{ config.generic_limit, config.generic_burst_ratio },
 	limiter_bootstrap{ config.bootstrap_limit, config.bootstrap_burst_ratio }
 {
 }
 
+nano::bandwidth_limiter::~bandwidth_limiter ()
+{
+	// Thread must be stopped before destruction
+	debug_assert (!thread.joinable ());
+}
+
+void nano::bandwidth_limiter::start ()
+{
+	debug_assert (!thread.joinable ());
+
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		started = true;
+	}
+	thread = std::thread{ [this] () {
+		nano::thread_role::set (nano::thread_role::name::bandwidth_shaper);
+		run ();
+	} };
+}
+
+void nano::bandwidth_limiter::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		stopped = true;
+		// Writes still waiting for budget are abandoned, the node is shutting down
+		waiters_generic.clear ();
+		waiters_bootstrap.clear ();
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
 nano::rate_limiter & nano::bandwidth_limiter::select_limiter (nano::transport::traffic_type type)
 {
 	switch (type)
@@ -29,18 +68,136 @@ nano::rate_limiter & nano::bandwidth_limiter::select_limiter (nano::transport::t
 	return limiter_generic;
 }
 
+auto nano::bandwidth_limiter::select_waiters (nano::transport::traffic_type type) -> std::deque<waiter> &
+{
+	return type == nano::transport::traffic_type::bootstrap ? waiters_bootstrap : waiters_generic;
+}
+
+auto nano::bandwidth_limiter::select_waiters (nano::transport::traffic_type type) const -> std::deque<waiter> const &
+{
+	return type == nano::transport::traffic_type::bootstrap ? waiters_bootstrap : waiters_generic;
+}
+
 bool nano::bandwidth_limiter::should_pass (std::size_t buffer_size, nano::transport::traffic_type type)
 {
 	auto & limiter = select_limiter (type);
 	return limiter.should_pass (buffer_size);
 }
 
+bool nano::bandwidth_limiter::acquire (std::size_t size, nano::transport::traffic_type type, resume_callback resume)
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto & waiters = select_waiters (type);
+	if (!started || stopped)
+	{
+		return true;
+	}
+	// Writes only bypass the queue when nobody is waiting, otherwise they would jump ahead of sockets already waiting for their share
+	auto & limiter = select_limiter (type);
+	if (waiters.empty () && limiter.should_pass (std::min (size, limiter.capacity ())))
+	{
+		stats.inc (nano::stat::type::bandwidth_shaper, nano::stat::detail::granted);
+		return true;
+	}
+	stats.inc (nano::stat::type::bandwidth_shaper, nano::stat::detail::queued);
+	auto const idle = waiters_generic.empty () && waiters_bootstrap.empty ();
+	waiters.push_back ({ size, 0, std::move (resume) });
+	if (idle)
+	{
+		// The shaper thread sleeps while nobody is waiting
+		condition.notify_all ();
+	}
+	return false;
+}
+
 void nano::bandwidth_limiter::reset (std::size_t limit, double burst_ratio, nano::transport::traffic_type type)
 {
 	auto & limiter = select_limiter (type);
 	limiter.reset (limit, burst_ratio);
 }
 
+void nano::bandwidth_limiter::run ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		if (waiters_generic.empty () && waiters_bootstrap.empty ())
+		{
+			condition.wait (lock, [this] () { return stopped || !waiters_generic.empty () || !waiters_bootstrap.empty (); });
+		}
+		else
+		{
+			// Tokens are refilled over time, give them a moment before serving again
+			condition.wait_for (lock, config.shaper_interval, [this] () { return stopped; });
+		}
+
+		if (!stopped)
+		{
+			std::vector<resume_callback> granted;
+			// Generic traffic carries votes and is served before bootstrap, which uses whatever the bootstrap budget has left
+			serve (nano::transport::traffic_type::generic, granted);
+			serve (nano::transport::traffic_type::bootstrap, granted);
+
+			if (!granted.empty ())
+			{
+				lock.unlock ();
+				stats.add (nano::stat::type::bandwidth_shaper, nano::stat::detail::resumed, granted.size ());
+				for (auto const & resume : granted)
+				{
+					resume ();
+				}
+				lock.lock ();
+			}
+		}
+	}
+}
+
+void nano::bandwidth_limiter::serve (nano::transport::traffic_type type, std::vector<resume_callback> & granted)
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto & limiter = select_limiter (type);
+	auto & waiters = select_waiters (type);
+	auto const capacity = limiter.capacity ();
+
+	// Each visit either grants the write at the front or tops up its deficit and moves it to the back, so every socket gets the same byte budget per round
+	while (!waiters.empty ())
+	{
+		auto & front = waiters.front ();
+		// Writes larger than the bucket would never pass, they are charged a full bucket instead
+		auto const cost = std::min (front.size, capacity);
+		if (front.deficit < cost)
+		{
+			front.deficit += config.shaper_quantum;
+			auto next = std::move (front);
+			waiters.pop_front ();
+			waiters.push_back (std::move (next));
+			continue;
+		}
+		if (!limiter.should_pass (cost))
+		{
+			break; // Out of tokens, this socket is first in line on the next refill
+		}
+		granted.push_back (std::move (front.resume));
+		waiters.pop_front ();
+	}
+}
+
+std::size_t nano::bandwidth_limiter::waiting (nano::transport::traffic_type type) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return select_waiters (type).size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::bandwidth_limiter::collect_container_info (std::string const & name) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "waiters_generic", waiters_generic.size (), sizeof (waiter) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "waiters_bootstrap", waiters_bootstrap.size (), sizeof (waiter) }));
+	return composite;
+}
+
 /*
  * bandwidth_limiter_config
  */
@@ -49,6 +206,8 @@ nano::bandwidth_limiter_config::bandwidth_limiter_config (nano::node_config cons
 	generic_limit{ node_config.bandwidth_limit },
 	generic_burst_ratio{ node_config.bandwidth_limit_burst_ratio },
 	bootstrap_limit{ node_config.bootstrap_bandwidth_limit },
-	bootstrap_burst_ratio{ node_config.bootstrap_bandwidth_burst_ratio }
+	bootstrap_burst_ratio{ node_config.bootstrap_bandwidth_burst_ratio },
+	shaper_quantum{ node_config.bandwidth_shaper_quantum },
+	shaper_interval{ node_config.bandwidth_shaper_interval }
 {
-}
\ No newline at end of file
+}
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <nano/lib/locks.hpp>
 #include <nano/lib/rate_limiting.hpp>
+#include <nano/lib/utility.hpp>
 #include <nano/node/fwd.hpp>
 #include <nano/node/transport/traffic_type.hpp>
 
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <thread>
+
 namespace nano
 {
 class bandwidth_limiter_config final
@@ -17,37 +24,83 @@ public:
 
 	std::size_t bootstrap_limit;
 	double bootstrap_burst_ratio;
+
+	/** Budget in bytes a waiting socket gains each deficit round robin round */
+	std::size_t shaper_quantum;
+	/** How often waiting sockets are served from refilled tokens */
+	std::chrono::milliseconds shaper_interval;
 };
 
 /**
  * Class that tracks and manages bandwidth limits for IO operations
+ * Socket writes are shaped instead of dropped: each traffic type has a global token bucket and once it runs dry,
+ * sockets wait in a deficit round robin so every peer gets a fair share of the bandwidth as tokens are refilled
  */
 class bandwidth_limiter final
 {
 public:
-	explicit bandwidth_limiter (nano::node_config const &);
+	using resume_callback = std::function<void ()>;
+
+public:
+	bandwidth_limiter (nano::node_config const &, nano::stats &);
+	~bandwidth_limiter ();
+
+	void start ();
+	void stop ();
 
 	/**
 	 * Check whether packet falls withing bandwidth limits and should be allowed
 	 * @return true if OK, false if needs to be dropped
 	 */
 	bool should_pass (std::size_t buffer_size, nano::transport::traffic_type type);
+	/**
+	 * Requests budget for a socket write of `size` bytes. Writes are never delayed while the shaper is not running
+	 * @return true if the write can proceed right away, otherwise `resume` is called from the shaper thread once the write is granted
+	 */
+	bool acquire (std::size_t size, nano::transport::traffic_type type, resume_callback resume);
 	/**
 	 * Reset limits of selected limiter type to values passed in arguments
 	 */
 	void reset (std::size_t limit, double burst_ratio, nano::transport::traffic_type type = nano::transport::traffic_type::generic);
 
+	/** Number of socket writes waiting for budget */
+	std::size_t waiting (nano::transport::traffic_type type) const;
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
 private:
+	struct waiter
+	{
+		std::size_t size;
+		std::size_t deficit;
+		resume_callback resume;
+	};
+
 	/**
 	 * Returns reference to limiter corresponding to the limit type
 	 */
 	nano::rate_limiter & select_limiter (nano::transport::traffic_type type);
+	std::deque<waiter> & select_waiters (nano::transport::traffic_type type);
+	std::deque<waiter> const & select_waiters (nano::transport::traffic_type type) const;
+
+	void run ();
+	/** Grants waiting writes in deficit round robin order until the bucket runs dry */
+	void serve (nano::transport::traffic_type type, std::vector<resume_callback> & granted);
 
 private:
 	bandwidth_limiter_config const config;
+	nano::stats & stats;
 
 private:
 	nano::rate_limiter limiter_generic;
 	nano::rate_limiter limiter_bootstrap;
+
+	std::deque<waiter> waiters_generic;
+	std::deque<waiter> waiters_bootstrap;
+
+	bool started{ false };
+	bool stopped{ false };
+	nano::condition_variable condition;
+	mutable nano::mutex mutex;
+	std::thread thread;
 };
-}
\ No newline at end of file
+}
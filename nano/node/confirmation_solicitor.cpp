@@ -1,15 +1,18 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/node/confirmation_solicitor.hpp>
 #include <nano/node/election.hpp>
+#include <nano/node/node.hpp>
 #include <nano/node/nodeconfig.hpp>
+#include <nano/node/online_reps.hpp>
 
 using namespace std::chrono_literals;
 
-nano::confirmation_solicitor::confirmation_solicitor (nano::network & network_a, nano::node_config const & config_a) :
+nano::confirmation_solicitor::confirmation_solicitor (nano::network & network_a, nano::online_reps & online_reps_a, nano::node_config const & config_a) :
 	max_block_broadcasts (config_a.network_params.network.is_dev_network () ? 4 : 30),
 	max_election_requests (50),
 	max_election_broadcasts (std::max<std::size_t> (network_a.fanout () / 2, 1)),
 	network (network_a),
+	online_reps (online_reps_a),
 	config (config_a)
 {
 }
@@ -19,7 +22,6 @@ void nano::confirmation_solicitor::prepare (std::vector<nano::representative> co
 	debug_assert (!prepared);
 	debug_assert (std::none_of (representatives_a.begin (), representatives_a.end (), [] (auto const & rep) { return rep.channel == nullptr; }));
 
-	requests.clear ();
 	rebroadcasted = 0;
 	/** Two copies are required as representatives can be erased from \p representatives_requests */
 	representatives_requests = representatives_a;
@@ -35,6 +37,7 @@ bool nano::confirmation_solicitor::broadcast (nano::election const & election_a)
 	{
 		auto const & hash (election_a.status.winner->hash ());
 		nano::publish winner{ config.network_params.network, election_a.status.winner };
+		auto const buffer = winner.to_shared_const_buffer ();
 		unsigned count = 0;
 		// Directed broadcasting to principal representatives
 		for (auto i (representatives_broadcasts.begin ()), n (representatives_broadcasts.end ()); i != n && count < max_election_broadcasts; ++i)
@@ -44,7 +47,7 @@ bool nano::confirmation_solicitor::broadcast (nano::election const & election_a)
 			bool const different (exists && existing->second.hash != hash);
 			if (!exists || different)
 			{
-				i->channel->send (winner);
+				i->channel->send (winner, buffer);
 				count += different ? 0 : 1;
 			}
 		}
@@ -61,6 +64,9 @@ bool nano::confirmation_solicitor::add (nano::election const & election_a)
 	bool error (true);
 	unsigned count = 0;
 	auto const & hash (election_a.status.winner->hash ());
+	auto const now = std::chrono::steady_clock::now ();
+	auto const delta = online_reps.delta ();
+	auto const tally_gap = delta > election_a.status.tally.number () ? delta - election_a.status.tally.number () : 0;
 	for (auto i (representatives_requests.begin ()); i != representatives_requests.end () && count < max_election_requests;)
 	{
 		bool full_queue (false);
@@ -74,7 +80,11 @@ bool nano::confirmation_solicitor::add (nano::election const & election_a)
 			auto & request_queue (requests[rep.channel]);
 			if (!rep.channel->max ())
 			{
-				request_queue.emplace_back (election_a.status.winner->hash (), election_a.status.winner->root ());
+				// A request still held back from a previous iteration covers this one
+				if (request_queue.hashes.insert (hash).second)
+				{
+					request_queue.entries.push_back ({ hash, election_a.status.winner->root (), now, election_a.get_election_start (), election_a.weak_from_this (), tally_gap });
+				}
 				count += different ? 0 : 1;
 				error = false;
 			}
@@ -91,25 +101,78 @@ bool nano::confirmation_solicitor::add (nano::election const & election_a)
 void nano::confirmation_solicitor::flush ()
 {
 	debug_assert (prepared);
-	for (auto const & request_queue : requests)
+	auto const cutoff = std::chrono::steady_clock::now () - config.active_elections.confirm_req_window;
+	auto const delta = online_reps.delta ();
+	for (auto it = requests.begin (); it != requests.end ();)
 	{
-		auto const & channel (request_queue.first);
-		std::vector<std::pair<nano::block_hash, nano::root>> roots_hashes_l;
-		for (auto const & root_hash : request_queue.second)
+		auto const & channel (it->first);
+		auto & [entries, hashes] = it->second;
+		if (!channel->alive ())
 		{
-			roots_hashes_l.push_back (root_hash);
-			if (roots_hashes_l.size () == nano::network::confirm_req_hashes_max)
+			it = requests.erase (it);
+			continue;
+		}
+		// Elections that ended while their requests were held back need no more votes
+		std::erase_if (entries, [&hashes = it->second.hashes] (request const & entry) {
+			auto election = entry.election.lock ();
+			if (!election || election->confirmed ())
+			{
+				hashes.erase (entry.hash);
+				return true;
+			}
+			return false;
+		});
+		// Tallies keep changing while requests are held back, refresh them from elections still alive
+		for (auto & entry : entries)
+		{
+			if (auto election = entry.election.lock ())
 			{
-				nano::confirm_req req{ config.network_params.network, roots_hashes_l };
-				channel->send (req);
-				roots_hashes_l.clear ();
+				auto const tally = election->get_status ().tally.number ();
+				entry.tally_gap = delta > tally ? delta - tally : 0;
 			}
 		}
-		if (!roots_hashes_l.empty ())
+		// Elections closest to quorum go first, then the oldest ones, the remainder is what waits for the next packet
+		std::sort (entries.begin (), entries.end (), [] (request const & lhs, request const & rhs) {
+			return lhs.tally_gap != rhs.tally_gap ? lhs.tally_gap < rhs.tally_gap : lhs.election_start < rhs.election_start;
+		});
+		auto const oldest = std::min_element (entries.begin (), entries.end (), [] (request const & lhs, request const & rhs) {
+			return lhs.time < rhs.time;
+		});
+		// Partial packets are sent once their oldest request waited for the whole window
+		bool const expired = oldest != entries.end () && oldest->time <= cutoff;
+		auto i = entries.begin ();
+		while (i != entries.end () && (entries.end () - i >= static_cast<std::ptrdiff_t> (nano::network::confirm_req_hashes_max) || expired))
 		{
+			auto const end = i + std::min<std::ptrdiff_t> (entries.end () - i, nano::network::confirm_req_hashes_max);
+			std::vector<std::pair<nano::block_hash, nano::root>> roots_hashes_l;
+			roots_hashes_l.reserve (end - i);
+			for (; i != end; ++i)
+			{
+				roots_hashes_l.emplace_back (i->hash, i->root);
+				hashes.erase (i->hash);
+			}
 			nano::confirm_req req{ config.network_params.network, roots_hashes_l };
 			channel->send (req);
 		}
+		entries.erase (entries.begin (), i);
+		it = entries.empty () ? requests.erase (it) : std::next (it);
 	}
 	prepared = false;
 }
+
+std::size_t nano::confirmation_solicitor::pending () const
+{
+	std::size_t result = 0;
+	for (auto const & [channel, queue] : requests)
+	{
+		result += queue.entries.size ();
+	}
+	return result;
+}
+
+bool nano::confirmation_solicitor::pending (nano::block_hash const & hash_a) const
+{
+	return std::any_of (requests.begin (), requests.end (), [&hash_a] (auto const & item) {
+		return item.second.hashes.contains (hash_a);
+	});
+}
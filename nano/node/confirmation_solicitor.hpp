@@ -3,26 +3,37 @@
 #include <nano/node/network.hpp>
 #include <nano/node/repcrawler.hpp>
 
+#include <chrono>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace nano
 {
 class election;
 class node;
 class node_config;
-/** This class accepts elections that need further votes before they can be confirmed and bundles them in to single confirm_req packets */
+class online_reps;
+/**
+ * This class accepts elections that need further votes before they can be confirmed and bundles them in to single confirm_req packets
+ * Requests that do not fill a packet are kept for up to `confirm_req_window` so requests from later iterations can fill it
+ */
 class confirmation_solicitor final
 {
 public:
-	confirmation_solicitor (nano::network &, nano::node_config const &);
-	/** Prepare object for batching election confirmation requests*/
+	confirmation_solicitor (nano::network &, nano::online_reps &, nano::node_config const &);
+	/** Prepare object for batching election confirmation requests, requests held back by the previous flush are kept */
 	void prepare (std::vector<nano::representative> const &);
 	/** Broadcast the winner of an election if the broadcast limit has not been reached. Returns false if the broadcast was performed */
 	bool broadcast (nano::election const &);
 	/** Add an election that needs to be confirmed. Returns false if successfully added */
 	bool add (nano::election const &);
-	/** Dispatch bundled requests to each channel*/
+	/** Dispatch full requests to each channel, and partial ones once they were held back for the batching window */
 	void flush ();
+	/** Number of requests held back for later packets */
+	std::size_t pending () const;
+	/** Whether a request for the hash is held back for a later packet */
+	bool pending (nano::block_hash const &) const;
 	/** Global maximum amount of block broadcasts */
 	std::size_t const max_block_broadcasts;
 	/** Maximum amount of requests to be sent per election, bypassed if an existing vote is for a different hash*/
@@ -32,13 +43,32 @@ public:
 
 private:
 	nano::network & network;
+	nano::online_reps & online_reps;
 	nano::node_config const & config;
 
+	class request
+	{
+	public:
+		nano::block_hash hash;
+		nano::root root;
+		/** When the request was first queued */
+		std::chrono::steady_clock::time_point time;
+		std::chrono::steady_clock::time_point election_start;
+		std::weak_ptr<nano::election const> election;
+		/** Weight still missing for quorum on the winner, refreshed on flush while the election is alive */
+		nano::uint128_t tally_gap;
+	};
+	class channel_requests
+	{
+	public:
+		std::vector<request> entries;
+		std::unordered_set<nano::block_hash> hashes;
+	};
+
 	unsigned rebroadcasted{ 0 };
 	std::vector<nano::representative> representatives_requests;
 	std::vector<nano::representative> representatives_broadcasts;
-	using vector_root_hashes = std::vector<std::pair<nano::block_hash, nano::root>>;
-	std::unordered_map<std::shared_ptr<nano::transport::channel>, vector_root_hashes> requests;
+	std::unordered_map<std::shared_ptr<nano::transport::channel>, channel_requests> requests;
 	bool prepared{ false };
 };
 }
@@ -28,6 +28,7 @@ class vote_cache;
 class vote_generator;
 class vote_processor;
 class vote_router;
+class vote_timestamps;
 class wallets;
 
 enum class block_source;
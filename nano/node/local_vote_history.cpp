@@ -18,7 +18,7 @@ bool nano::local_vote_history::consistency_check (nano::root const & root_a) con
 	return result;
 }
 
-void nano::local_vote_history::add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a)
+void nano::local_vote_history::add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a, std::optional<nano::shared_const_buffer> const & confirm_ack_a)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	clean ();
@@ -45,7 +45,7 @@ void nano::local_vote_history::add (nano::root const & root_a, nano::block_hash
 	// Do not add new vote to cache if representative account is same and timestamp is lower
 	if (add_vote)
 	{
-		auto result (history_by_root.emplace (root_a, hash_a, vote_a));
+		auto result (history_by_root.emplace (root_a, hash_a, vote_a, confirm_ack_a));
 		(void)result;
 		debug_assert (result.second);
 	}
@@ -82,6 +82,19 @@ std::vector<std::shared_ptr<nano::vote>> nano::local_vote_history::votes (nano::
 	return result;
 }
 
+std::vector<nano::local_vote_history::cached_vote> nano::local_vote_history::cached (nano::root const & root_a, nano::block_hash const & hash_a, bool const is_final_a) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	std::vector<cached_vote> result;
+	auto range (history.get<tag_root> ().equal_range (root_a));
+	// clang-format off
+	nano::transform_if (range.first, range.second, std::back_inserter (result),
+		[&hash_a, is_final_a](auto const & entry) { return entry.hash == hash_a && (!is_final_a || entry.vote->timestamp () == std::numeric_limits<uint64_t>::max ()); },
+		[](auto const & entry) { return cached_vote{ entry.vote, entry.confirm_ack }; });
+	// clang-format on
+	return result;
+}
+
 bool nano::local_vote_history::exists (nano::root const & root_a) const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
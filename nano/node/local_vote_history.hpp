@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nano/lib/asio.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
 
@@ -9,6 +10,7 @@
 #include <boost/multi_index_container.hpp>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace mi = boost::multi_index;
@@ -27,15 +29,26 @@ class local_vote_history final
 	class local_vote final
 	{
 	public:
-		local_vote (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a) :
+		local_vote (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a, std::optional<nano::shared_const_buffer> const & confirm_ack_a) :
 			root (root_a),
 			hash (hash_a),
-			vote (vote_a)
+			vote (vote_a),
+			confirm_ack (confirm_ack_a)
 		{
 		}
 		nano::root root;
 		nano::block_hash hash;
 		std::shared_ptr<nano::vote> vote;
+		std::optional<nano::shared_const_buffer> confirm_ack;
+	};
+
+public:
+	/** A cached vote with the confirm_ack it was serialized to, if that was provided when it was added */
+	class cached_vote final
+	{
+	public:
+		std::shared_ptr<nano::vote> vote;
+		std::optional<nano::shared_const_buffer> confirm_ack;
 	};
 
 public:
@@ -43,10 +56,12 @@ public:
 		constants{ constants }
 	{
 	}
-	void add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a);
+	/** \p confirm_ack_a is the serialized confirm_ack for \p vote_a, it is shared by every entry of the same vote */
+	void add (nano::root const & root_a, nano::block_hash const & hash_a, std::shared_ptr<nano::vote> const & vote_a, std::optional<nano::shared_const_buffer> const & confirm_ack_a = std::nullopt);
 	void erase (nano::root const & root_a);
 
 	std::vector<std::shared_ptr<nano::vote>> votes (nano::root const & root_a, nano::block_hash const & hash_a, bool const is_final_a = false) const;
+	std::vector<cached_vote> cached (nano::root const & root_a, nano::block_hash const & hash_a, bool const is_final_a = false) const;
 	bool exists (nano::root const &) const;
 	std::size_t size () const;
 
@@ -11,11 +11,11 @@ nano::message_processor::message_processor (message_processor_config const & con
 	logger{ node.logger }
 {
 	queue.max_size_query = [this] (auto const & origin) {
-		return config.max_queue;
+		return max_size_query (origin.source);
 	};
 
 	queue.priority_query = [this] (auto const & origin) {
-		return 1;
+		return priority_query (origin.source);
 	};
 }
 
@@ -85,10 +85,22 @@ bool nano::message_processor::put (std::unique_ptr<nano::message> message, std::
 
 	auto const type = message->type ();
 
+	// Duplicates were already dropped by the network filter during deserialization, the vote processor has its own fair queue
+	if (config.fast_vote_routing && type == nano::message_type::confirm_ack)
+	{
+		stats.inc (nano::stat::type::message_processor, nano::stat::detail::fast_route);
+		process (*message, channel);
+		return true;
+	}
+
 	bool added = false;
 	{
 		nano::lock_guard<nano::mutex> guard{ mutex };
-		added = queue.push ({ std::move (message), channel }, { nano::no_value{}, channel });
+		added = queue.push ({ std::move (message), channel, std::chrono::steady_clock::now () }, { type, channel });
+		if (added)
+		{
+			++queued_by_type[type];
+		}
 	}
 	if (added)
 	{
@@ -138,14 +150,23 @@ void nano::message_processor::run_batch (nano::unique_lock<nano::mutex> & lock)
 
 	size_t const max_batch_size = 1024 * 4;
 	auto batch = queue.next_batch (max_batch_size);
+	for (auto const & [entry, origin] : batch)
+	{
+		--queued_by_type[origin.source];
+	}
 
 	lock.unlock ();
 
 	for (auto const & [entry, origin] : batch)
 	{
-		auto const & [message, channel] = entry;
-		release_assert (message != nullptr);
-		process (*message, channel);
+		release_assert (entry.message != nullptr);
+
+		// Time spent queued, per type totals divided by the message_processor_type counters give the average latency
+		auto const latency = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - entry.added);
+		stats.add (nano::stat::type::message_processor_latency, to_stat_detail (origin.source), latency.count ());
+		stats.sample (nano::stat::sample::message_processor_latency, latency.count () / 1000, { 0, 1000 });
+
+		process (*entry.message, entry.channel);
 	}
 
 	if (timer.since_start () > std::chrono::milliseconds (100))
@@ -290,12 +311,54 @@ void nano::message_processor::process (nano::message const & message, std::share
 	message.visit (visitor);
 }
 
+size_t nano::message_processor::max_size_query (nano::message_type type) const
+{
+	switch (type)
+	{
+		case nano::message_type::keepalive:
+		case nano::message_type::telemetry_req:
+		case nano::message_type::telemetry_ack:
+			return config.max_control_queue;
+		default:
+			return config.max_queue;
+	}
+}
+
+size_t nano::message_processor::priority_query (nano::message_type type) const
+{
+	switch (type)
+	{
+		case nano::message_type::publish:
+			return config.priority_publish;
+		case nano::message_type::confirm_ack:
+			return config.priority_confirm_ack;
+		case nano::message_type::confirm_req:
+			return config.priority_confirm_req;
+		case nano::message_type::asc_pull_req:
+		case nano::message_type::asc_pull_ack:
+			return config.priority_bootstrap;
+		default:
+			return config.priority_control;
+	}
+}
+
+size_t nano::message_processor::size (nano::message_type type) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	auto it = queued_by_type.find (type);
+	return it == queued_by_type.end () ? 0 : it->second;
+}
+
 std::unique_ptr<nano::container_info_component> nano::message_processor::collect_container_info (std::string const & name)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 
 	auto composite = std::make_unique<container_info_composite> (name);
 	composite->add_component (queue.collect_container_info ("queue"));
+	for (auto const & [type, count] : queued_by_type)
+	{
+		composite->add_component (std::make_unique<container_info_leaf> (container_info{ std::string{ to_string (type) }, count, sizeof (entry_t) }));
+	}
 	return composite;
 }
 
@@ -306,7 +369,14 @@ std::unique_ptr<nano::container_info_component> nano::message_processor::collect
 nano::error nano::message_processor_config::serialize (nano::tomlconfig & toml) const
 {
 	toml.put ("threads", threads, "Number of threads to use for message processing. \ntype:uint64");
-	toml.put ("max_queue", max_queue, "Maximum number of messages per peer to queue for processing. \ntype:uint64");
+	toml.put ("max_queue", max_queue, "Maximum number of messages of each type per peer to queue for processing. \ntype:uint64");
+	toml.put ("max_control_queue", max_control_queue, "Maximum number of keepalive and telemetry messages of each type per peer to queue for processing. \ntype:uint64");
+	toml.put ("priority_publish", priority_publish, "Priority for publish messages. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("priority_confirm_ack", priority_confirm_ack, "Priority for vote messages. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("priority_confirm_req", priority_confirm_req, "Priority for vote request messages. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("priority_bootstrap", priority_bootstrap, "Priority for ascending bootstrap messages. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("priority_control", priority_control, "Priority for keepalive, telemetry and other messages. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("fast_vote_routing", fast_vote_routing, "Pass votes directly from the network threads to the vote processor, skipping the message processor queue. Lowers vote latency at the cost of more work on network threads. \ntype:bool");
 
 	return toml.get_error ();
 }
@@ -315,6 +385,13 @@ nano::error nano::message_processor_config::deserialize (nano::tomlconfig & toml
 {
 	toml.get ("threads", threads);
 	toml.get ("max_queue", max_queue);
+	toml.get ("max_control_queue", max_control_queue);
+	toml.get ("priority_publish", priority_publish);
+	toml.get ("priority_confirm_ack", priority_confirm_ack);
+	toml.get ("priority_confirm_req", priority_confirm_req);
+	toml.get ("priority_bootstrap", priority_bootstrap);
+	toml.get ("priority_control", priority_control);
+	toml.get ("fast_vote_routing", fast_vote_routing);
 
 	return toml.get_error ();
 }
\ No newline at end of file
@@ -4,7 +4,10 @@
 #include <nano/lib/threading.hpp>
 #include <nano/node/fair_queue.hpp>
 #include <nano/node/fwd.hpp>
+#include <nano/node/messages.hpp>
 
+#include <chrono>
+#include <map>
 #include <thread>
 #include <vector>
 
@@ -19,9 +22,19 @@ public:
 public:
 	size_t threads{ std::clamp (nano::hardware_concurrency () / 4, 1u, 2u) };
 	size_t max_queue{ 64 };
+	size_t max_control_queue{ 8 };
+	size_t priority_publish{ 4 };
+	size_t priority_confirm_ack{ 4 };
+	size_t priority_confirm_req{ 2 };
+	size_t priority_bootstrap{ 2 };
+	size_t priority_control{ 1 };
+	/** Hand confirm_ack messages straight to the vote processor from the receiving I/O thread instead of queueing them here */
+	bool fast_vote_routing{ false };
 };
 
 /*
+ * Messages are queued separately per message type and channel, so a flood of one type from one peer only fills its own queue
+ * and queues are serviced round robin with a per type priority.
  * If mutex locking is ever a performance bottleneck, using a lock-free queue in front of the priority queue should be considered.
  */
 class message_processor final
@@ -36,11 +49,16 @@ public:
 	bool put (std::unique_ptr<nano::message>, std::shared_ptr<nano::transport::channel> const &);
 	void process (nano::message const &, std::shared_ptr<nano::transport::channel> const &);
 
+	/** Number of queued messages of the given type across all channels */
+	size_t size (nano::message_type) const;
+
 	std::unique_ptr<container_info_component> collect_container_info (std::string const & name);
 
 private:
 	void run ();
 	void run_batch (nano::unique_lock<nano::mutex> &);
+	size_t max_size_query (nano::message_type) const;
+	size_t priority_query (nano::message_type) const;
 
 private: // Dependencies
 	message_processor_config const & config;
@@ -49,11 +67,17 @@ private: // Dependencies
 	nano::logger & logger;
 
 private:
-	using entry_t = std::pair<std::unique_ptr<nano::message>, std::shared_ptr<nano::transport::channel>>;
-	nano::fair_queue<entry_t, nano::no_value> queue;
+	struct entry_t
+	{
+		std::unique_ptr<nano::message> message;
+		std::shared_ptr<nano::transport::channel> channel;
+		std::chrono::steady_clock::time_point added;
+	};
+	nano::fair_queue<entry_t, nano::message_type> queue;
+	std::map<nano::message_type, size_t> queued_by_type;
 
 	std::atomic<bool> stopped{ false };
-	nano::mutex mutex;
+	mutable nano::mutex mutex;
 	nano::condition_variable condition;
 	std::vector<std::thread> threads;
 };
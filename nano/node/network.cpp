@@ -8,6 +8,7 @@
 #include <nano/node/node.hpp>
 #include <nano/node/portmapping.hpp>
 #include <nano/node/telemetry.hpp>
+#include <nano/node/transport/message_deserializer.hpp>
 
 using namespace std::chrono_literals;
 
@@ -26,6 +27,7 @@ nano::network::network (nano::node & node, uint16_t port) :
 	syn_cookies{ node.config.network.max_peers_per_ip, node.logger },
 	resolver{ node.io_ctx },
 	filter{ node.config.network.duplicate_filter_size, node.config.network.duplicate_filter_cutoff },
+	receive_buffers{ nano::transport::message_deserializer::MAX_MESSAGE_SIZE, node.config.network.receive_buffer_pool_size, node.stats },
 	tcp_channels{ node },
 	port{ port }
 {
@@ -233,9 +235,10 @@ void nano::network::send_keepalive_self (std::shared_ptr<nano::transport::channe
 
 void nano::network::flood_message (nano::message & message_a, nano::transport::buffer_drop_policy const drop_policy_a, float const scale_a)
 {
+	auto const buffer = message_a.to_shared_const_buffer ();
 	for (auto & i : list (fanout (scale_a)))
 	{
-		i->send (message_a, nullptr, drop_policy_a);
+		i->send (message_a, buffer, nullptr, drop_policy_a);
 	}
 }
 
@@ -262,31 +265,53 @@ void nano::network::flood_block (std::shared_ptr<nano::block> const & block, nan
 void nano::network::flood_block_initial (std::shared_ptr<nano::block> const & block)
 {
 	nano::publish message{ node.network_params.network, block, /* is_originator */ true };
+	auto const buffer = message.to_shared_const_buffer ();
 	for (auto const & rep : node.rep_crawler.principal_representatives ())
 	{
-		rep.channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		rep.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 	for (auto & peer : list_non_pr (fanout (1.0)))
 	{
-		peer->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		peer->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 }
 
 void nano::network::flood_vote (std::shared_ptr<nano::vote> const & vote, float scale, bool rebroadcasted)
 {
 	nano::confirm_ack message{ node.network_params.network, vote, rebroadcasted };
+	auto const buffer = message.to_shared_const_buffer ();
 	for (auto & i : list (fanout (scale)))
 	{
-		i->send (message, nullptr);
+		i->send (message, buffer, nullptr);
 	}
 }
 
 void nano::network::flood_vote_pr (std::shared_ptr<nano::vote> const & vote, bool rebroadcasted)
 {
 	nano::confirm_ack message{ node.network_params.network, vote, rebroadcasted };
+	auto const buffer = message.to_shared_const_buffer ();
 	for (auto const & i : node.rep_crawler.principal_representatives ())
 	{
-		i.channel->send (message, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+		i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
+	}
+}
+
+void nano::network::flood_vote (std::shared_ptr<nano::vote> const & vote, nano::shared_const_buffer const & buffer, float scale)
+{
+	// The message is only used for its type, the payload is the already serialized buffer
+	nano::confirm_ack message{ node.network_params.network, vote };
+	for (auto & i : list (fanout (scale)))
+	{
+		i->send (message, buffer, nullptr);
+	}
+}
+
+void nano::network::flood_vote_pr (std::shared_ptr<nano::vote> const & vote, nano::shared_const_buffer const & buffer)
+{
+	nano::confirm_ack message{ node.network_params.network, vote };
+	for (auto const & i : node.rep_crawler.principal_representatives ())
+	{
+		i.channel->send (message, buffer, nullptr, nano::transport::buffer_drop_policy::no_limiter_drop);
 	}
 }
 
@@ -694,6 +719,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (ne
 	composite->add_component (network.tcp_channels.collect_container_info ("tcp_channels"));
 	composite->add_component (network.syn_cookies.collect_container_info ("syn_cookies"));
 	composite->add_component (network.excluded_peers.collect_container_info ("excluded_peers"));
+	composite->add_component (network.receive_buffers.collect_container_info ("receive_buffers"));
 	return composite;
 }
 
@@ -5,6 +5,7 @@
 #include <nano/node/common.hpp>
 #include <nano/node/messages.hpp>
 #include <nano/node/peer_exclusion.hpp>
+#include <nano/node/transport/buffer_pool.hpp>
 #include <nano/node/transport/common.hpp>
 #include <nano/node/transport/fwd.hpp>
 #include <nano/node/transport/tcp_channels.hpp>
@@ -80,6 +81,9 @@ public:
 
 	size_t duplicate_filter_size{ 1024 * 1024 };
 	uint64_t duplicate_filter_cutoff{ 60 };
+
+	/** Maximum number of idle receive buffers kept for reuse */
+	size_t receive_buffer_pool_size{ 256 };
 };
 
 class network final
@@ -96,6 +100,9 @@ public:
 	void flood_keepalive_self (float const scale_a = 0.5f);
 	void flood_vote (std::shared_ptr<nano::vote> const &, float scale, bool rebroadcasted = false);
 	void flood_vote_pr (std::shared_ptr<nano::vote> const &, bool rebroadcasted = false);
+	/** Floods a vote that was already serialized to a confirm_ack, \p buffer must be `confirm_ack{ vote }.to_shared_const_buffer ()` */
+	void flood_vote (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const & buffer, float scale);
+	void flood_vote_pr (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const & buffer);
 	// Flood block to all PRs and a random selection of non-PRs
 	void flood_block_initial (std::shared_ptr<nano::block> const &);
 	// Flood block to a random selection of peers
@@ -152,6 +159,7 @@ public:
 	boost::asio::ip::tcp::resolver resolver;
 	nano::peer_exclusion excluded_peers;
 	nano::network_filter filter;
+	nano::transport::buffer_pool receive_buffers;
 	nano::transport::tcp_channels tcp_channels;
 	std::atomic<uint16_t> port{ 0 };
 
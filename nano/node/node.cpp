@@ -1,5 +1,7 @@
+#include <nano/lib/asio.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/stream.hpp>
+#include <nano/lib/thread_roles.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/lib/utility.hpp>
@@ -26,10 +28,13 @@
 #include <nano/node/scheduler/optimistic.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/node/telemetry.hpp>
+#include <nano/node/transport/io_pool.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/vote_generator.hpp>
 #include <nano/node/vote_processor.hpp>
+#include <nano/node/vote_rebroadcaster.hpp>
 #include <nano/node/vote_router.hpp>
+#include <nano/node/vote_timestamps.hpp>
 #include <nano/node/websocket.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
@@ -73,6 +78,8 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	logger{ make_logger_identifier (node_id) },
 	runner_impl{ std::make_unique<nano::thread_runner> (io_ctx_shared, logger, config.io_threads) },
 	runner{ *runner_impl },
+	io_pool_impl{ std::make_unique<nano::transport::io_pool> (config.io_pinned_threads, io_ctx_shared, logger) },
+	io_pool{ *io_pool_impl },
 	node_initialized_latch (1),
 	network_params{ config.network_params },
 	stats{ logger, config.stats_config },
@@ -83,14 +90,14 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	flags (flags_a),
 	work (work_a),
 	distributed_work (*this),
-	store_impl (nano::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade, flags.force_use_write_queue)),
+	store_impl (nano::make_store (logger, application_path_a, network_params.ledger, flags.read_only, true, config_a.rocksdb_config, config_a.diagnostics_config.txn_tracking, config_a.block_processor_batch_max_time, config_a.lmdb_config, config_a.backup_before_upgrade, flags.force_use_write_queue, flags.memory_store, config_a.write_queue)),
 	store (*store_impl),
 	unchecked{ config.max_unchecked_blocks, stats, flags.disable_block_processor_unchecked_deletion },
 	wallets_store_impl (std::make_unique<nano::mdb_wallets_store> (application_path_a / "wallets.ldb", config_a.lmdb_config)),
 	wallets_store (*wallets_store_impl),
 	ledger_impl{ std::make_unique<nano::ledger> (store, stats, network_params.ledger, flags_a.generate_cache, config_a.representative_vote_weight_minimum.number ()) },
 	ledger{ *ledger_impl },
-	outbound_limiter_impl{ std::make_unique<nano::bandwidth_limiter> (config) },
+	outbound_limiter_impl{ std::make_unique<nano::bandwidth_limiter> (config, stats) },
 	outbound_limiter{ *outbound_limiter_impl },
 	message_processor_impl{ std::make_unique<nano::message_processor> (config.message_processor, *this) },
 	message_processor{ *message_processor_impl },
@@ -126,9 +133,11 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	history{ *history_impl },
 	vote_uniquer{},
 	vote_cache{ config.vote_cache, stats },
+	vote_timestamps_impl{ std::make_unique<nano::vote_timestamps> (config.vote_processor.max_timestamps) },
+	vote_timestamps{ *vote_timestamps_impl },
 	vote_router_impl{ std::make_unique<nano::vote_router> (vote_cache, active.recently_confirmed) },
 	vote_router{ *vote_router_impl },
-	vote_processor_impl{ std::make_unique<nano::vote_processor> (config.vote_processor, vote_router, observers, stats, flags, logger, online_reps, rep_crawler, ledger, network_params, rep_tiers) },
+	vote_processor_impl{ std::make_unique<nano::vote_processor> (config.vote_processor, vote_router, observers, stats, flags, logger, online_reps, rep_crawler, ledger, network_params, rep_tiers, vote_timestamps) },
 	vote_processor{ *vote_processor_impl },
 	vote_cache_processor_impl{ std::make_unique<nano::vote_cache_processor> (config.vote_processor, vote_router, vote_cache, stats, logger) },
 	vote_cache_processor{ *vote_cache_processor_impl },
@@ -149,6 +158,8 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	epoch_upgrader{ *this, ledger, store, network_params, logger },
 	local_block_broadcaster_impl{ std::make_unique<nano::local_block_broadcaster> (config.local_block_broadcaster, *this, block_processor, network, confirming_set, stats, logger, !flags.disable_block_processor_republishing) },
 	local_block_broadcaster{ *local_block_broadcaster_impl },
+	vote_rebroadcaster_impl{ std::make_unique<nano::vote_rebroadcaster> (config.vote_rebroadcaster, ledger, network, active.recently_confirmed, stats) },
+	vote_rebroadcaster{ *vote_rebroadcaster_impl },
 	process_live_dispatcher{ ledger, scheduler.priority, vote_cache, websocket },
 	peer_history_impl{ std::make_unique<nano::peer_history> (config.peer_history, store, network, logger, stats) },
 	peer_history{ *peer_history_impl },
@@ -169,6 +180,19 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 		return ledger.weight (rep);
 	};
 
+	store.write_queue.acquired.add ([this] (nano::store::writer writer, auto waited) {
+		auto const waited_us = std::chrono::duration_cast<std::chrono::microseconds> (waited).count ();
+		stats.inc (nano::stat::type::write_queue, nano::to_stat_detail (writer));
+		stats.add (nano::stat::type::write_queue_wait, nano::to_stat_detail (writer), waited_us);
+		stats.sample (nano::stat::sample::write_queue_wait, waited_us / 1000, { 0, config.write_queue.max_hold.count () * 10 });
+	});
+
+	store.write_queue.released.add ([this] (nano::store::writer writer, auto held) {
+		auto const held_us = std::chrono::duration_cast<std::chrono::microseconds> (held).count ();
+		stats.add (nano::stat::type::write_queue_hold, nano::to_stat_detail (writer), held_us);
+		stats.sample (nano::stat::sample::write_queue_hold, held_us / 1000, { 0, config.write_queue.max_hold.count () * 10 });
+	});
+
 	// Republish vote if it is new and the node does not host a principal representative (or close to)
 	vote_router.vote_processed.add ([this] (std::shared_ptr<nano::vote> const & vote, nano::vote_source source, std::unordered_map<nano::block_hash, nano::vote_code> const & results) {
 		bool processed = std::any_of (results.begin (), results.end (), [] (auto const & result) {
@@ -179,7 +203,7 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 			auto const reps = wallets.reps ();
 			if (!reps.have_half_rep () && !reps.exists (vote->account))
 			{
-				network.flood_vote (vote, 0.5f, /* rebroadcasted */ true);
+				vote_rebroadcaster.push (vote, results);
 			}
 		}
 	});
@@ -299,6 +323,8 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 		logger.info (nano::log::type::node, "Build information: {}", BUILD_INFO);
 		logger.info (nano::log::type::node, "Active network: {}", network_label);
 		logger.info (nano::log::type::node, "Database backend: {}", store.vendor_get ());
+		logger.info (nano::log::type::node, "Network I/O backend: {}", nano::asio_backend ());
+		logger.info (nano::log::type::node, "Pinned I/O threads: {}", io_pool.size ());
 		logger.info (nano::log::type::node, "Data path: {}", application_path.string ());
 		logger.info (nano::log::type::node, "Work pool threads: {} ({})", work.threads.size (), (work.opencl ? "OpenCL" : "CPU"));
 		logger.info (nano::log::type::node, "Work peers: {}", config.work_peers.size ());
@@ -524,6 +550,8 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (node.ledger.collect_container_info ("ledger"));
 	composite->add_component (collect_container_info (node.active, "active"));
 	composite->add_component (node.tcp_listener.collect_container_info ("tcp_listener"));
+	composite->add_component (node.io_pool.collect_container_info ("io_pool"));
+	composite->add_component (node.outbound_limiter.collect_container_info ("outbound_limiter"));
 	composite->add_component (collect_container_info (node.network, "network"));
 	composite->add_component (node.telemetry.collect_container_info ("telemetry"));
 	composite->add_component (node.workers.collect_container_info ("workers"));
@@ -533,6 +561,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (collect_container_info (node.observers, "observers"));
 	composite->add_component (collect_container_info (node.wallets, "wallets"));
 	composite->add_component (node.vote_processor.collect_container_info ("vote_processor"));
+	composite->add_component (node.vote_timestamps.collect_container_info ("vote_timestamps"));
 	composite->add_component (node.vote_cache_processor.collect_container_info ("vote_cache_processor"));
 	composite->add_component (node.rep_crawler.collect_container_info ("rep_crawler"));
 	composite->add_component (node.block_processor.collect_container_info ("block_processor"));
@@ -551,6 +580,7 @@ std::unique_ptr<nano::container_info_component> nano::collect_container_info (no
 	composite->add_component (node.ascendboot.collect_container_info ("bootstrap_ascending"));
 	composite->add_component (node.unchecked.collect_container_info ("unchecked"));
 	composite->add_component (node.local_block_broadcaster.collect_container_info ("local_block_broadcaster"));
+	composite->add_component (node.vote_rebroadcaster.collect_container_info ("vote_rebroadcaster"));
 	composite->add_component (node.rep_tiers.collect_container_info ("rep_tiers"));
 	composite->add_component (node.message_processor.collect_container_info ("message_processor"));
 	return composite;
@@ -598,6 +628,13 @@ void nano::node::start ()
 			this_l->ongoing_ledger_pruning ();
 		});
 	}
+	if (config.lmdb_config.compaction_interval.count () > 0 && !flags.read_only)
+	{
+		compaction_thread = std::thread ([this] () {
+			nano::thread_role::set (nano::thread_role::name::ledger_compaction);
+			run_ledger_compaction ();
+		});
+	}
 	if (!flags.disable_rep_crawler)
 	{
 		rep_crawler.start ();
@@ -639,6 +676,7 @@ void nano::node::start ()
 	unchecked.start ();
 	wallets.start ();
 	rep_tiers.start ();
+	outbound_limiter.start ();
 	vote_processor.start ();
 	vote_cache_processor.start ();
 	block_processor.start ();
@@ -658,6 +696,7 @@ void nano::node::start ()
 	telemetry.start ();
 	stats.start ();
 	local_block_broadcaster.start ();
+	vote_rebroadcaster.start ();
 	peer_history.start ();
 	vote_router.start ();
 	monitor.start ();
@@ -706,13 +745,25 @@ void nano::node::stop ()
 	stats.stop ();
 	epoch_upgrader.stop ();
 	workers.stop ();
+	{
+		nano::lock_guard<nano::mutex> guard{ compaction_mutex };
+	}
+	compaction_condition.notify_all ();
+	if (compaction_thread.joinable ())
+	{
+		compaction_thread.join ();
+	}
 	local_block_broadcaster.stop ();
+	vote_rebroadcaster.stop ();
 	message_processor.stop ();
+	outbound_limiter.stop ();
 	network.stop (); // Stop network last to avoid killing in-use sockets
 	monitor.stop ();
 
 	// work pool is not stopped on purpose due to testing setup
 
+	// Sockets are closed at this point, pinned contexts have no more work
+	io_pool.stop ();
 	// Stop the IO runner last
 	runner.join ();
 	debug_assert (io_ctx_shared.use_count () == 1); // Node should be the last user of the io_context
@@ -785,6 +836,7 @@ void nano::node::long_inactivity_cleanup ()
 	{
 		store.online_weight.clear (transaction);
 		store.peer.clear (transaction);
+		online_reps.clear_samples ();
 		logger.info (nano::log::type::node, "Removed records of peers and online weight after a long period of inactivity");
 	}
 }
@@ -896,6 +948,7 @@ void nano::node::ledger_pruning (uint64_t const batch_size_a, bool bootstrap_wei
 			auto write_transaction = ledger.tx_begin_write ({ tables::blocks, tables::pruned }, nano::store::writer::pruning);
 			while (!pruning_targets.empty () && transaction_write_count < batch_size_a && !stopped)
 			{
+				write_transaction.refresh_if_needed ();
 				auto const & pruning_hash (pruning_targets.front ());
 				auto account_pruned_count (ledger.pruning_action (write_transaction, pruning_hash, batch_size_a));
 				transaction_write_count += account_pruned_count;
@@ -923,6 +976,22 @@ void nano::node::ongoing_ledger_pruning ()
 	});
 }
 
+void nano::node::run_ledger_compaction ()
+{
+	nano::unique_lock<nano::mutex> lock{ compaction_mutex };
+	while (!stopped)
+	{
+		compaction_condition.wait_for (lock, config.lmdb_config.compaction_interval, [this] () { return stopped.load (); });
+		if (!stopped)
+		{
+			lock.unlock ();
+			// Not applicable to all stores
+			store.compact ();
+			lock.lock ();
+		}
+	}
+}
+
 int nano::node::price (nano::uint128_t const & balance_a, int amount_a)
 {
 	debug_assert (balance_a >= amount_a * nano::Gxrb_ratio);
@@ -31,6 +31,7 @@
 #include <atomic>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <vector>
 
 namespace nano
@@ -45,7 +46,9 @@ class node;
 class telemetry;
 class vote_processor;
 class vote_cache_processor;
+class vote_rebroadcaster;
 class vote_router;
+class vote_timestamps;
 class work_pool;
 class peer_history;
 class port_mapping;
@@ -57,6 +60,7 @@ namespace scheduler
 }
 namespace transport
 {
+	class io_pool;
 	class tcp_listener;
 }
 namespace bootstrap_ascending
@@ -107,6 +111,7 @@ public:
 	bool collect_ledger_pruning_targets (std::deque<nano::block_hash> &, nano::account &, uint64_t const, uint64_t const, uint64_t const);
 	void ledger_pruning (uint64_t const, bool);
 	void ongoing_ledger_pruning ();
+	void run_ledger_compaction ();
 	int price (nano::uint128_t const &, int);
 	// The default difficulty updates to base only when the first epoch_2 block is processed
 	uint64_t default_difficulty (nano::work_version const) const;
@@ -148,6 +153,8 @@ public:
 	nano::logger logger;
 	std::unique_ptr<nano::thread_runner> runner_impl;
 	nano::thread_runner & runner;
+	std::unique_ptr<nano::transport::io_pool> io_pool_impl;
+	nano::transport::io_pool & io_pool;
 	boost::latch node_initialized_latch;
 	nano::network_params & network_params;
 	nano::stats stats;
@@ -193,6 +200,8 @@ public:
 	nano::block_uniquer block_uniquer;
 	nano::vote_uniquer vote_uniquer;
 	nano::vote_cache vote_cache;
+	std::unique_ptr<nano::vote_timestamps> vote_timestamps_impl;
+	nano::vote_timestamps & vote_timestamps;
 	std::unique_ptr<nano::vote_router> vote_router_impl;
 	nano::vote_router & vote_router;
 	std::unique_ptr<nano::vote_processor> vote_processor_impl;
@@ -216,6 +225,8 @@ public:
 	nano::epoch_upgrader epoch_upgrader;
 	std::unique_ptr<nano::local_block_broadcaster> local_block_broadcaster_impl;
 	nano::local_block_broadcaster & local_block_broadcaster;
+	std::unique_ptr<nano::vote_rebroadcaster> vote_rebroadcaster_impl;
+	nano::vote_rebroadcaster & vote_rebroadcaster;
 	nano::process_live_dispatcher process_live_dispatcher;
 	std::unique_ptr<nano::peer_history> peer_history_impl;
 	nano::peer_history & peer_history;
@@ -251,6 +262,11 @@ public: // Testing convenience functions
 private:
 	void long_inactivity_cleanup ();
 
+	// Compaction copies the whole ledger, it runs on its own thread instead of tying up a worker
+	std::thread compaction_thread;
+	nano::mutex compaction_mutex;
+	nano::condition_variable compaction_condition;
+
 	static std::string make_logger_identifier (nano::keypair const & node_id);
 };
 
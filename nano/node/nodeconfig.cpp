@@ -106,6 +106,7 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("representative_vote_weight_minimum", representative_vote_weight_minimum.to_string_dec (), "Minimum vote weight that a representative must have for its vote to be counted.\nAll representatives above this weight will be kept in memory!\ntype:string,amount,raw");
 	toml.put ("password_fanout", password_fanout, "Password fanout factor.\ntype:uint64");
 	toml.put ("io_threads", io_threads, "Number of threads dedicated to I/O operations. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
+	toml.put ("io_pinned_threads", io_pinned_threads, "Number of additional I/O threads, each running its own io_context that peer sockets are pinned to when connected. Keeps the handlers of a socket on a single thread for better cache locality under high peer counts. 0 disables pinning and runs sockets on the io_threads pool.\ntype:uint64");
 	toml.put ("network_threads", network_threads, "Number of threads dedicated to processing network messages. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("background_threads", background_threads, "Number of threads dedicated to background node work, including handling of RPC requests. Defaults to all available CPU threads.\ntype:uint64");
@@ -121,6 +122,8 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("vote_minimum", vote_minimum.to_string_dec (), "Local representatives do not vote if the delegated weight is under this threshold. Saves on system resources.\ntype:string,amount,raw");
 	toml.put ("vote_generator_delay", vote_generator_delay.count (), "Delay before votes are sent to allow for efficient bundling of hashes in votes.\ntype:milliseconds");
 	toml.put ("vote_generator_threshold", vote_generator_threshold, "Number of bundled hashes required for an additional generator delay.\ntype:uint64,[1..11]");
+	toml.put ("vote_generator_adaptive", vote_generator_adaptive, "Adapt the delay before votes are sent to the rate of new candidates. Votes are sent without delay at low load and wait up to twice vote_generator_delay for a full bundle at high load.\ntype:bool");
+	toml.put ("vote_generator_threads", vote_generator_threads, "Number of threads used to sign generated votes. Values above 1 sign votes in parallel to the vote generator thread.\ntype:uint64");
 	toml.put ("unchecked_cutoff_time", unchecked_cutoff_time.count (), "Number of seconds before deleting an unchecked entry.\nWarning: lower values (e.g., 3600 seconds, or 1 hour) may result in unsuccessful bootstraps, especially a bootstrap from scratch.\ntype:seconds");
 	toml.put ("tcp_io_timeout", tcp_io_timeout.count (), "Timeout for TCP connect-, read- and write operations.\nWarning: a low value (e.g., below 5 seconds) may result in TCP connections failing.\ntype:seconds");
 	toml.put ("pow_sleep_interval", pow_sleep_interval.count (), "Time to sleep between batch work generation attempts. Reduces max CPU usage at the expense of a longer generation time.\ntype:nanoseconds");
@@ -135,6 +138,9 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("bootstrap_bandwidth_limit", bootstrap_bandwidth_limit, "Outbound bootstrap traffic limit in bytes/sec after which messages will be dropped.\nNote: changing to unlimited bandwidth (0) is not recommended for limited connections.\ntype:uint64");
 	toml.put ("bootstrap_bandwidth_burst_ratio", bootstrap_bandwidth_burst_ratio, "Burst ratio for outbound bootstrap traffic.\ntype:double");
 
+	toml.put ("bandwidth_shaper_quantum", bandwidth_shaper_quantum, "Bytes a socket waiting for outbound bandwidth is credited each round, peers waiting for bandwidth are served in turn with this budget.\ntype:uint64");
+	toml.put ("bandwidth_shaper_interval", bandwidth_shaper_interval.count (), "How often sockets waiting for outbound bandwidth are served from refilled tokens.\ntype:milliseconds");
+
 	toml.put ("confirming_set_batch_time", confirming_set_batch_time.count (), "Maximum time the confirming set will hold the database write transaction.\ntype:milliseconds");
 	toml.put ("backup_before_upgrade", backup_before_upgrade, "Backup the ledger database before performing upgrades.\nWarning: uses more disk storage and increases startup time when upgrading.\ntype:bool");
 	toml.put ("max_work_generate_multiplier", max_work_generate_multiplier, "Maximum allowed difficulty multiplier for work generation.\ntype:double,[1..]");
@@ -243,6 +249,10 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	vote_processor.serialize (vote_processor_l);
 	toml.put_child ("vote_processor", vote_processor_l);
 
+	nano::tomlconfig vote_rebroadcaster_l;
+	vote_rebroadcaster.serialize (vote_rebroadcaster_l);
+	toml.put_child ("vote_rebroadcaster", vote_rebroadcaster_l);
+
 	nano::tomlconfig peer_history_l;
 	peer_history.serialize (peer_history_l);
 	toml.put_child ("peer_history", peer_history_l);
@@ -255,6 +265,10 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	message_processor.serialize (message_processor_l);
 	toml.put_child ("message_processor", message_processor_l);
 
+	nano::tomlconfig tcp_l;
+	tcp.serialize (tcp_l);
+	toml.put_child ("tcp", tcp_l);
+
 	nano::tomlconfig monitor_l;
 	monitor.serialize (monitor_l);
 	toml.put_child ("monitor", monitor_l);
@@ -263,6 +277,10 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	backlog_population.serialize (backlog_population_l);
 	toml.put_child ("backlog_population", backlog_population_l);
 
+	nano::tomlconfig write_queue_l;
+	write_queue.serialize (write_queue_l);
+	toml.put_child ("write_queue", write_queue_l);
+
 	return toml.get_error ();
 }
 
@@ -372,6 +390,12 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 			vote_processor.deserialize (config_l);
 		}
 
+		if (toml.has_key ("vote_rebroadcaster"))
+		{
+			auto config_l = toml.get_required_child ("vote_rebroadcaster");
+			vote_rebroadcaster.deserialize (config_l);
+		}
+
 		if (toml.has_key ("peer_history"))
 		{
 			auto config_l = toml.get_required_child ("peer_history");
@@ -390,6 +414,12 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 			message_processor.deserialize (config_l);
 		}
 
+		if (toml.has_key ("tcp"))
+		{
+			auto config_l = toml.get_required_child ("tcp");
+			tcp.deserialize (config_l);
+		}
+
 		if (toml.has_key ("monitor"))
 		{
 			auto config_l = toml.get_required_child ("monitor");
@@ -402,6 +432,12 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 			backlog_population.deserialize (config_l);
 		}
 
+		if (toml.has_key ("write_queue"))
+		{
+			auto config_l = toml.get_required_child ("write_queue");
+			write_queue.deserialize (config_l);
+		}
+
 		/*
 		 * Values
 		 */
@@ -485,6 +521,8 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		vote_generator_delay = std::chrono::milliseconds (delay_l);
 
 		toml.get<unsigned> ("vote_generator_threshold", vote_generator_threshold);
+		toml.get<bool> ("vote_generator_adaptive", vote_generator_adaptive);
+		toml.get<unsigned> ("vote_generator_threads", vote_generator_threads);
 
 		auto block_processor_batch_max_time_l = block_processor_batch_max_time.count ();
 		toml.get ("block_processor_batch_max_time", block_processor_batch_max_time_l);
@@ -508,6 +546,7 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<unsigned> ("bootstrap_fraction_numerator", bootstrap_fraction_numerator);
 		toml.get<unsigned> ("password_fanout", password_fanout);
 		toml.get<unsigned> ("io_threads", io_threads);
+		toml.get<unsigned> ("io_pinned_threads", io_pinned_threads);
 		toml.get<unsigned> ("work_threads", work_threads);
 		toml.get<unsigned> ("network_threads", network_threads);
 		toml.get<unsigned> ("background_threads", background_threads);
@@ -543,6 +582,11 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<std::size_t> ("bootstrap_bandwidth_limit", bootstrap_bandwidth_limit);
 		toml.get<double> ("bootstrap_bandwidth_burst_ratio", bootstrap_bandwidth_burst_ratio);
 
+		toml.get<std::size_t> ("bandwidth_shaper_quantum", bandwidth_shaper_quantum);
+		auto bandwidth_shaper_interval_l (bandwidth_shaper_interval.count ());
+		toml.get ("bandwidth_shaper_interval", bandwidth_shaper_interval_l);
+		bandwidth_shaper_interval = std::chrono::milliseconds (bandwidth_shaper_interval_l);
+
 		toml.get<bool> ("backup_before_upgrade", backup_before_upgrade);
 
 		auto confirming_set_batch_time_l (confirming_set_batch_time.count ());
@@ -604,6 +648,10 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		{
 			toml.get_error ().set ("vote_generator_threshold must be a number between 1 and 11");
 		}
+		if (vote_generator_threads < 1)
+		{
+			toml.get_error ().set ("vote_generator_threads must be at least 1");
+		}
 		if (max_work_generate_multiplier < 1)
 		{
 			toml.get_error ().set ("max_work_generate_multiplier must be greater than or equal to 1");
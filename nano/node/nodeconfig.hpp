@@ -29,9 +29,11 @@
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/vote_cache.hpp>
 #include <nano/node/vote_processor.hpp>
+#include <nano/node/vote_rebroadcaster.hpp>
 #include <nano/node/websocketconfig.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/generate_cache_flags.hpp>
+#include <nano/store/write_queue.hpp>
 
 #include <chrono>
 #include <optional>
@@ -74,6 +76,10 @@ public:
 	nano::amount rep_crawler_weight_minimum{ "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF" };
 	std::chrono::milliseconds vote_generator_delay{ std::chrono::milliseconds (100) };
 	unsigned vote_generator_threshold{ 3 };
+	/** Size the bundling delay from the observed candidate rate instead of always waiting vote_generator_delay */
+	bool vote_generator_adaptive{ true };
+	/** Number of threads signing generated votes, with a single thread votes are signed by the vote generator thread itself */
+	unsigned vote_generator_threads{ 1 };
 	nano::amount online_weight_minimum{ 60000 * nano::Gxrb_ratio };
 	/*
 	 * The minimum vote weight that a representative must have for its vote to be counted.
@@ -82,6 +88,8 @@ public:
 	nano::amount representative_vote_weight_minimum{ 10 * nano::Mxrb_ratio };
 	unsigned password_fanout{ 1024 };
 	unsigned io_threads{ env_io_threads ().value_or (std::max (4u, nano::hardware_concurrency ())) };
+	/** Number of single threaded io_contexts peer sockets are pinned to, 0 runs all sockets on the shared io_threads pool */
+	unsigned io_pinned_threads{ 0 };
 	unsigned network_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned work_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned background_threads{ std::max (4u, nano::hardware_concurrency ()) };
@@ -121,6 +129,10 @@ public:
 	std::size_t bootstrap_bandwidth_limit{ 5 * 1024 * 1024 };
 	/** Bootstrap traffic does not need bursts */
 	double bootstrap_bandwidth_burst_ratio{ 1. };
+	/** Budget in bytes a socket waiting for outbound bandwidth gains each deficit round robin round */
+	std::size_t bandwidth_shaper_quantum{ 16 * 1024 };
+	/** How often sockets waiting for outbound bandwidth are served from refilled tokens */
+	std::chrono::milliseconds bandwidth_shaper_interval{ 5 };
 	nano::bootstrap_ascending_config bootstrap_ascending;
 	nano::bootstrap_server_config bootstrap_server;
 	std::chrono::milliseconds confirming_set_batch_time{ 250 };
@@ -139,6 +151,7 @@ public:
 	nano::block_processor_config block_processor;
 	nano::active_elections_config active_elections;
 	nano::vote_processor_config vote_processor;
+	nano::vote_rebroadcaster_config vote_rebroadcaster;
 	nano::peer_history_config peer_history;
 	nano::transport::tcp_config tcp;
 	nano::request_aggregator_config request_aggregator;
@@ -148,6 +161,7 @@ public:
 	nano::confirming_set_config confirming_set;
 	nano::monitor_config monitor;
 	nano::backlog_population_config backlog_population;
+	nano::store::write_queue_config write_queue;
 
 public:
 	/** Entry is ignored if it cannot be parsed as a valid address:port */
@@ -187,6 +201,7 @@ public:
 	bool enable_pruning{ false };
 	bool fast_bootstrap{ false };
 	bool read_only{ false };
+	bool memory_store{ false }; // Ledger is kept in memory only and not persisted
 	bool disable_connection_cleanup{ false };
 	nano::generate_cache_flags generate_cache;
 	bool inactive_node{ false };
@@ -6,53 +6,120 @@
 
 nano::online_reps::online_reps (nano::ledger & ledger_a, nano::node_config const & config_a) :
 	ledger{ ledger_a },
-	config{ config_a }
+	config{ config_a },
+	samples{ config_a.network_params.node.max_weight_samples }
 {
 	if (!ledger.store.init_error ())
 	{
 		auto transaction (ledger.store.tx_begin_read ());
-		trended_m = calculate_trend (transaction);
+		for (auto i (ledger.store.online_weight.begin (transaction)), n (ledger.store.online_weight.end ()); i != n; ++i)
+		{
+			samples.push_back (i->second.number ());
+		}
+		trended_m = calculate_trend ();
 	}
+	ledger.cache.rep_weights.track_changes (true);
+}
+
+nano::online_reps::~online_reps ()
+{
+	ledger.cache.rep_weights.track_changes (false);
 }
 
 void nano::online_reps::observe (nano::account const & rep_a)
 {
-	if (ledger.weight (rep_a) > 0)
+	auto const weight = ledger.weight (rep_a);
+	if (weight > 0)
 	{
 		nano::lock_guard<nano::mutex> lock{ mutex };
+		update_weights ();
 		auto now = std::chrono::steady_clock::now ();
-		auto new_insert = reps.get<tag_account> ().erase (rep_a) == 0;
-		reps.insert ({ now, rep_a });
-		auto cutoff = reps.get<tag_time> ().lower_bound (now - std::chrono::seconds (config.network_params.node.weight_period));
-		auto trimmed = reps.get<tag_time> ().begin () != cutoff;
-		reps.get<tag_time> ().erase (reps.get<tag_time> ().begin (), cutoff);
-		if (new_insert || trimmed)
+		auto existing = reps.get<tag_account> ().find (rep_a);
+		if (existing != reps.get<tag_account> ().end ())
+		{
+			online_m = online_m - existing->weight + weight;
+			reps.get<tag_account> ().modify (existing, [now, weight] (rep_info & info) {
+				info.time = now;
+				info.weight = weight;
+			});
+		}
+		else
 		{
-			online_m = calculate_online ();
+			reps.insert ({ now, rep_a, weight });
+			online_m += weight;
 		}
+		trim (now);
+	}
+}
+
+void nano::online_reps::update_weights () const
+{
+	debug_assert (!mutex.try_lock ());
+	auto & by_account = reps.get<tag_account> ();
+	for (auto const & rep : ledger.cache.rep_weights.take_changes ())
+	{
+		// Changes to representatives that are not online are dropped without a weight lookup
+		auto existing = by_account.find (rep);
+		if (existing != by_account.end ())
+		{
+			// Bootstrap weights may override the ledger, always use the weight the rest of the node sees
+			auto const weight = ledger.weight (rep);
+			online_m = online_m - existing->weight + weight;
+			by_account.modify (existing, [weight] (rep_info & info) {
+				info.weight = weight;
+			});
+		}
+	}
+}
+
+void nano::online_reps::trim (std::chrono::steady_clock::time_point now)
+{
+	debug_assert (!mutex.try_lock ());
+	auto & by_time = reps.get<tag_time> ();
+	auto cutoff = by_time.lower_bound (now - std::chrono::seconds (config.network_params.node.weight_period));
+	for (auto i = by_time.begin (); i != cutoff; ++i)
+	{
+		online_m -= i->weight;
 	}
+	by_time.erase (by_time.begin (), cutoff);
 }
 
 void nano::online_reps::sample ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
+	trim (std::chrono::steady_clock::now ());
+	// Every weight is refreshed below, changes recorded so far are covered by it
+	ledger.cache.rep_weights.take_changes ();
+	// Weights are tracked as they change, refreshing them corrects for bulk changes such as leaving bootstrap weights
+	for (auto i = reps.begin (), n = reps.end (); i != n; ++i)
+	{
+		reps.modify (i, [this] (rep_info & info) {
+			info.weight = ledger.weight (info.account);
+		});
+	}
+	online_m = calculate_online ();
 	nano::uint128_t online_l = online_m;
+	samples.push_back (online_l);
+	trended_m = calculate_trend ();
 	lock.unlock ();
-	nano::uint128_t trend_l;
+
+	// Samples are persisted to restore the trend after restarts
+	auto transaction (ledger.store.tx_begin_write ({ tables::online_weight }));
+	// Discard oldest entries
+	while (ledger.store.online_weight.count (transaction) >= config.network_params.node.max_weight_samples)
 	{
-		auto transaction (ledger.store.tx_begin_write ({ tables::online_weight }));
-		// Discard oldest entries
-		while (ledger.store.online_weight.count (transaction) >= config.network_params.node.max_weight_samples)
-		{
-			auto oldest (ledger.store.online_weight.begin (transaction));
-			debug_assert (oldest != ledger.store.online_weight.end ());
-			ledger.store.online_weight.del (transaction, oldest->first);
-		}
-		ledger.store.online_weight.put (transaction, std::chrono::system_clock::now ().time_since_epoch ().count (), online_l);
-		trend_l = calculate_trend (transaction);
+		auto oldest (ledger.store.online_weight.begin (transaction));
+		debug_assert (oldest != ledger.store.online_weight.end ());
+		ledger.store.online_weight.del (transaction, oldest->first);
 	}
-	lock.lock ();
-	trended_m = trend_l;
+	ledger.store.online_weight.put (transaction, std::chrono::system_clock::now ().time_since_epoch ().count (), online_l);
+}
+
+void nano::online_reps::clear_samples ()
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	samples.clear ();
+	trended_m = calculate_trend ();
 }
 
 nano::uint128_t nano::online_reps::calculate_online () const
@@ -60,20 +127,17 @@ nano::uint128_t nano::online_reps::calculate_online () const
 	nano::uint128_t current;
 	for (auto & i : reps)
 	{
-		current += ledger.weight (i.account);
+		current += i.weight;
 	}
 	return current;
 }
 
-nano::uint128_t nano::online_reps::calculate_trend (store::transaction & transaction_a) const
+nano::uint128_t nano::online_reps::calculate_trend () const
 {
 	std::vector<nano::uint128_t> items;
-	items.reserve (config.network_params.node.max_weight_samples + 1);
+	items.reserve (samples.size () + 1);
 	items.push_back (config.online_weight_minimum.number ());
-	for (auto i (ledger.store.online_weight.begin (transaction_a)), n (ledger.store.online_weight.end ()); i != n; ++i)
-	{
-		items.push_back (i->second.number ());
-	}
+	items.insert (items.end (), samples.begin (), samples.end ());
 	nano::uint128_t result;
 	// Pick median value for our target vote weight
 	auto median_idx = items.size () / 2;
@@ -91,12 +155,14 @@ nano::uint128_t nano::online_reps::trended () const
 nano::uint128_t nano::online_reps::online () const
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	update_weights ();
 	return online_m;
 }
 
 nano::uint128_t nano::online_reps::delta () const
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	update_weights ();
 	// Using a larger container to ensure maximum precision
 	auto weight = static_cast<nano::uint256_t> (std::max ({ online_m, trended_m, config.online_weight_minimum.number () }));
 	return ((weight * online_weight_quorum) / 100).convert_to<nano::uint128_t> ();
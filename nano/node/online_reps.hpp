@@ -4,6 +4,7 @@
 #include <nano/lib/utility.hpp>
 #include <nano/secure/common.hpp>
 
+#include <boost/circular_buffer.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -21,15 +22,22 @@ namespace store
 	class transaction;
 }
 
-/** Track online representatives and trend online weight */
+/**
+ * Track online representatives and trend online weight
+ * Online weight is kept up to date as representatives are observed and as their weights change in the ledger,
+ * the trend is the median of the most recent samples kept in memory
+ */
 class online_reps final
 {
 public:
 	online_reps (nano::ledger & ledger_a, nano::node_config const & config_a);
+	~online_reps ();
 	/** Add voting account \p rep_account to the set of online representatives */
 	void observe (nano::account const & rep_account);
 	/** Called periodically to sample online weight */
 	void sample ();
+	/** Drops online weight samples, used after they are removed from the ledger */
+	void clear_samples ();
 	/** Returns the trended online stake */
 	nano::uint128_t trended () const;
 	/** Returns the current online stake */
@@ -47,6 +55,7 @@ private:
 	public:
 		std::chrono::steady_clock::time_point time;
 		nano::account account;
+		nano::uint128_t weight;
 	};
 	class tag_time
 	{
@@ -54,20 +63,27 @@ private:
 	class tag_account
 	{
 	};
-	nano::uint128_t calculate_trend (store::transaction &) const;
+	/** Applies ledger weight changes recorded since the last call to online reps, requires the mutex */
+	void update_weights () const;
+	/** Removes reps not observed within the weight period, requires the mutex */
+	void trim (std::chrono::steady_clock::time_point now);
+	nano::uint128_t calculate_trend () const;
 	nano::uint128_t calculate_online () const;
 	mutable nano::mutex mutex;
 	nano::ledger & ledger;
 	nano::node_config const & config;
-	boost::multi_index_container<rep_info,
+	// Mutable along with online_m, weight changes are applied lazily from const getters
+	mutable boost::multi_index_container<rep_info,
 	boost::multi_index::indexed_by<
 	boost::multi_index::ordered_non_unique<boost::multi_index::tag<tag_time>,
 	boost::multi_index::member<rep_info, std::chrono::steady_clock::time_point, &rep_info::time>>,
 	boost::multi_index::hashed_unique<boost::multi_index::tag<tag_account>,
 	boost::multi_index::member<rep_info, nano::account, &rep_info::account>>>>
 	reps;
+	/** Most recent online weight samples, oldest first */
+	boost::circular_buffer<nano::uint128_t> samples;
 	nano::uint128_t trended_m;
-	nano::uint128_t online_m;
+	mutable nano::uint128_t online_m;
 	nano::uint128_t minimum;
 
 	friend class election_quorum_minimum_update_weight_before_quorum_checks_Test;
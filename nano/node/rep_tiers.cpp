@@ -49,6 +49,33 @@ void nano::rep_tiers::stop ()
 nano::rep_tier nano::rep_tiers::tier (const nano::account & representative) const
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	return tier_impl (representative);
+}
+
+std::optional<uint32_t> nano::rep_tiers::rep_id (nano::account const & representative) const
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (auto existing = rep_ids.find (representative); existing != rep_ids.end ())
+	{
+		return existing->second;
+	}
+	return std::nullopt;
+}
+
+std::pair<nano::rep_tier, std::optional<uint32_t>> nano::rep_tiers::tier_id (nano::account const & representative) const
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (auto existing = rep_ids.find (representative); existing != rep_ids.end ())
+	{
+		return { tier_impl (representative), existing->second };
+	}
+	// Every representative that reached tier 1 has an id assigned
+	return { nano::rep_tier::none, std::nullopt };
+}
+
+nano::rep_tier nano::rep_tiers::tier_impl (nano::account const & representative) const
+{
+	debug_assert (!mutex.try_lock ());
 	if (representatives_3.find (representative) != representatives_3.end ())
 	{
 		return nano::rep_tier::tier_3;
@@ -129,6 +156,14 @@ void nano::rep_tiers::calculate_tiers ()
 		representatives_1 = std::move (representatives_1_l);
 		representatives_2 = std::move (representatives_2_l);
 		representatives_3 = std::move (representatives_3_l);
+		for (auto const & representative : representatives_1)
+		{
+			if (!rep_ids.contains (representative))
+			{
+				auto const id = nano::narrow_cast<uint32_t> (rep_ids.size ());
+				rep_ids.emplace (representative, id);
+			}
+		}
 	}
 
 	stats.inc (nano::stat::type::rep_tiers, nano::stat::detail::updated);
@@ -141,6 +176,7 @@ std::unique_ptr<nano::container_info_component> nano::rep_tiers::collect_contain
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_1", representatives_1.size (), sizeof (decltype (representatives_1)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_2", representatives_2.size (), sizeof (decltype (representatives_2)::value_type) }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "representatives_3", representatives_3.size (), sizeof (decltype (representatives_3)::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "rep_ids", rep_ids.size (), sizeof (decltype (rep_ids)::value_type) }));
 	return composite;
 }
 
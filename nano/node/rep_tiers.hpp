@@ -5,8 +5,11 @@
 #include <nano/secure/common.hpp>
 
 #include <memory>
+#include <optional>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace nano
 {
@@ -39,6 +42,10 @@ public:
 
 	/** Returns the representative tier for the account */
 	nano::rep_tier tier (nano::account const & representative) const;
+	/** Returns a dense id for representatives that reached at least tier 1, ids are never reassigned while the node runs */
+	std::optional<uint32_t> rep_id (nano::account const & representative) const;
+	/** Returns both the tier and the dense id under a single lock */
+	std::pair<nano::rep_tier, std::optional<uint32_t>> tier_id (nano::account const & representative) const;
 
 	std::unique_ptr<container_info_component> collect_container_info (std::string const & name);
 
@@ -52,12 +59,15 @@ private: // Dependencies
 private:
 	void run ();
 	void calculate_tiers ();
+	nano::rep_tier tier_impl (nano::account const & representative) const;
 
 private:
 	/** Representatives levels for early prioritization */
 	std::unordered_set<nano::account> representatives_1;
 	std::unordered_set<nano::account> representatives_2;
 	std::unordered_set<nano::account> representatives_3;
+	/** Dense representative ids, used by compact per-representative indexes */
+	std::unordered_map<nano::account, uint32_t> rep_ids;
 
 	std::atomic<bool> stopped{ false };
 	nano::condition_variable condition;
@@ -25,11 +25,11 @@ nano::request_aggregator::request_aggregator (request_aggregator_config const &
 	generator (generator_a),
 	final_generator (final_generator_a)
 {
-	generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
-		this->reply_action (vote_a, channel_a);
+	generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, nano::shared_const_buffer const & buffer_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
+		this->reply_action (vote_a, buffer_a, channel_a);
 	});
-	final_generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
-		this->reply_action (vote_a, channel_a);
+	final_generator.set_reply_action ([this] (std::shared_ptr<nano::vote> const & vote_a, nano::shared_const_buffer const & buffer_a, std::shared_ptr<nano::transport::channel> const & channel_a) {
+		this->reply_action (vote_a, buffer_a, channel_a);
 	});
 
 	queue.max_size_query = [this] (auto const & origin) {
@@ -150,17 +150,31 @@ void nano::request_aggregator::run_batch (nano::unique_lock<nano::mutex> & lock)
 
 	lock.unlock ();
 
+	// Requests from different channels often ask for the same hashes, look each of them up only once per batch
+	std::vector<std::pair<nano::block_hash, nano::root>> keys;
+	std::vector<bool> full;
+	full.reserve (batch.size ());
+	for (auto const & [value, origin] : batch)
+	{
+		auto const & [request, channel] = value;
+		full.push_back (channel->max ());
+		if (!full.back ())
+		{
+			keys.insert (keys.end (), request.begin (), request.end ());
+		}
+	}
+
 	auto transaction = ledger.tx_begin_read ();
+	auto const resolved = resolve (transaction, std::move (keys));
 
+	auto full_it = full.begin ();
 	for (auto const & [value, origin] : batch)
 	{
 		auto const & [request, channel] = value;
 
-		transaction.refresh_if_needed ();
-
-		if (!channel->max ())
+		if (!*full_it++)
 		{
-			process (transaction, request, channel);
+			process (resolved, request, channel);
 		}
 		else
 		{
@@ -169,9 +183,9 @@ void nano::request_aggregator::run_batch (nano::unique_lock<nano::mutex> & lock)
 	}
 }
 
-void nano::request_aggregator::process (nano::secure::transaction const & transaction, request_type const & request, std::shared_ptr<nano::transport::channel> const & channel)
+void nano::request_aggregator::process (resolutions_t const & resolved, request_type const & request, std::shared_ptr<nano::transport::channel> const & channel)
 {
-	auto const remaining = aggregate (transaction, request, channel);
+	auto const remaining = aggregate (resolved, request);
 
 	if (!remaining.remaining_normal.empty ())
 	{
@@ -191,10 +205,11 @@ void nano::request_aggregator::process (nano::secure::transaction const & transa
 	}
 }
 
-void nano::request_aggregator::reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const
+void nano::request_aggregator::reply_action (std::shared_ptr<nano::vote> const & vote_a, nano::shared_const_buffer const & buffer_a, std::shared_ptr<nano::transport::channel> const & channel_a) const
 {
+	// The vote is already serialized by the generator, the message is only needed for its type
 	nano::confirm_ack confirm{ network_constants, vote_a };
-	channel_a->send (confirm);
+	channel_a->send (confirm, buffer_a);
 }
 
 void nano::request_aggregator::erase_duplicates (std::vector<std::pair<nano::block_hash, nano::root>> & requests_a) const
@@ -208,70 +223,120 @@ void nano::request_aggregator::erase_duplicates (std::vector<std::pair<nano::blo
 	requests_a.end ());
 }
 
-auto nano::request_aggregator::aggregate (nano::secure::transaction const & transaction, request_type const & requests_a, std::shared_ptr<nano::transport::channel> const & channel_a) const -> aggregate_result
+auto nano::request_aggregator::resolve (nano::secure::read_transaction & transaction, std::vector<std::pair<nano::block_hash, nano::root>> keys) const -> resolutions_t
 {
-	std::vector<std::shared_ptr<nano::block>> to_generate;
-	std::vector<std::shared_ptr<nano::block>> to_generate_final;
-	for (auto const & [hash, root] : requests_a)
+	stats.add (nano::stat::type::request_aggregator, nano::stat::detail::batch_hashes, keys.size ());
+
+	// Sorted keys visit the block table in order, which keeps consecutive lookups close together in the database
+	std::sort (keys.begin (), keys.end ());
+	keys.erase (std::unique (keys.begin (), keys.end ()), keys.end ());
+	stats.add (nano::stat::type::request_aggregator, nano::stat::detail::batch_hashes_unique, keys.size ());
+
+	resolutions_t result;
+	lookup_cache cache;
+	for (auto const & [hash, root] : keys)
 	{
-		bool generate_final_vote (false);
-		std::shared_ptr<nano::block> block;
+		transaction.refresh_if_needed ();
+		result.emplace_hint (result.end (), std::make_pair (hash, root), resolve (transaction, hash, root, cache));
+	}
+	return result;
+}
+
+auto nano::request_aggregator::resolve (nano::secure::transaction const & transaction, nano::block_hash const & hash, nano::root const & root, lookup_cache & cache) const -> resolution
+{
+	resolution result;
+	std::shared_ptr<nano::block> block;
 
-		// 2. Final votes
-		auto final_vote_hashes (ledger.store.final_vote.get (transaction, root));
-		if (!final_vote_hashes.empty ())
+	// 2. Final votes
+	auto final_vote_hashes (ledger.store.final_vote.get (transaction, root));
+	if (!final_vote_hashes.empty ())
+	{
+		result.final = true;
+		block = block_get (transaction, final_vote_hashes[0], cache);
+		// Allow same root vote
+		if (block != nullptr && final_vote_hashes.size () > 1)
 		{
-			generate_final_vote = true;
-			block = ledger.any.block_get (transaction, final_vote_hashes[0]);
-			// Allow same root vote
-			if (block != nullptr && final_vote_hashes.size () > 1)
-			{
-				// WTF? This shouldn't be done like this
-				to_generate_final.push_back (block);
-				block = ledger.any.block_get (transaction, final_vote_hashes[1]);
-				debug_assert (final_vote_hashes.size () == 2);
-			}
+			// WTF? This shouldn't be done like this
+			result.final_blocks.push_back (block);
+			block = block_get (transaction, final_vote_hashes[1], cache);
+			debug_assert (final_vote_hashes.size () == 2);
 		}
+	}
 
-		// 4. Ledger by hash
-		if (block == nullptr)
+	// 4. Ledger by hash
+	if (block == nullptr)
+	{
+		block = block_get (transaction, hash, cache);
+		// Confirmation status. Generate final votes for confirmed
+		if (block != nullptr)
 		{
-			block = ledger.any.block_get (transaction, hash);
-			// Confirmation status. Generate final votes for confirmed
-			if (block != nullptr)
-			{
-				nano::confirmation_height_info confirmation_height_info;
-				ledger.store.confirmation_height.get (transaction, block->account (), confirmation_height_info);
-				generate_final_vote = (confirmation_height_info.height >= block->sideband ().height);
-			}
+			result.final = confirmed (transaction, *block, cache);
 		}
+	}
 
-		// 5. Ledger by root
-		if (block == nullptr && !root.is_zero ())
+	// 5. Ledger by root
+	if (block == nullptr && !root.is_zero ())
+	{
+		// Search for block root
+		auto successor = ledger.any.block_successor (transaction, root.as_block_hash ());
+		if (successor)
 		{
-			// Search for block root
-			auto successor = ledger.any.block_successor (transaction, root.as_block_hash ());
-			if (successor)
+			auto successor_block = block_get (transaction, successor.value (), cache);
+			release_assert (successor_block != nullptr);
+			block = std::move (successor_block);
+
+			// Confirmation status. Generate final votes for confirmed successor
+			if (block != nullptr)
 			{
-				auto successor_block = ledger.any.block_get (transaction, successor.value ());
-				release_assert (successor_block != nullptr);
-				block = std::move (successor_block);
-
-				// Confirmation status. Generate final votes for confirmed successor
-				if (block != nullptr)
-				{
-					nano::confirmation_height_info confirmation_height_info;
-					ledger.store.confirmation_height.get (transaction, block->account (), confirmation_height_info);
-					generate_final_vote = (confirmation_height_info.height >= block->sideband ().height);
-				}
+				result.final = confirmed (transaction, *block, cache);
 			}
 		}
+	}
+
+	result.block = std::move (block);
+	return result;
+}
+
+std::shared_ptr<nano::block> nano::request_aggregator::block_get (nano::secure::transaction const & transaction, nano::block_hash const & hash, lookup_cache & cache) const
+{
+	// Final vote hashes, requested hashes and successors overlap, each block is only deserialized once per batch
+	auto [existing, inserted] = cache.blocks.try_emplace (hash);
+	if (inserted)
+	{
+		existing->second = ledger.any.block_get (transaction, hash);
+	}
+	return existing->second;
+}
+
+bool nano::request_aggregator::confirmed (nano::secure::transaction const & transaction, nano::block const & block, lookup_cache & cache) const
+{
+	// Only the height is needed, blocks of the same account share a single confirmation height lookup
+	auto [existing, inserted] = cache.heights.try_emplace (block.account ());
+	if (inserted)
+	{
+		nano::confirmation_height_info confirmation_height_info;
+		ledger.store.confirmation_height.get (transaction, block.account (), confirmation_height_info);
+		existing->second = confirmation_height_info.height;
+	}
+	return existing->second >= block.sideband ().height;
+}
+
+auto nano::request_aggregator::aggregate (resolutions_t const & resolved, request_type const & requests_a) const -> aggregate_result
+{
+	std::vector<std::shared_ptr<nano::block>> to_generate;
+	std::vector<std::shared_ptr<nano::block>> to_generate_final;
+	for (auto const & [hash, root] : requests_a)
+	{
+		auto existing = resolved.find (std::make_pair (hash, root));
+		debug_assert (existing != resolved.end ());
+		auto const & resolution = existing->second;
 
-		if (block)
+		to_generate_final.insert (to_generate_final.end (), resolution.final_blocks.begin (), resolution.final_blocks.end ());
+		if (resolution.block)
 		{
-			if (generate_final_vote)
+			if (resolution.final)
 			{
-				to_generate_final.push_back (block);
+				to_generate_final.push_back (resolution.block);
 				stats.inc (nano::stat::type::requests, nano::stat::detail::requests_final);
 			}
 			else
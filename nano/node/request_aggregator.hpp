@@ -14,6 +14,7 @@
 #include <boost/multi_index_container.hpp>
 
 #include <condition_variable>
+#include <map>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -66,7 +67,32 @@ public:
 private:
 	void run ();
 	void run_batch (nano::unique_lock<nano::mutex> & lock);
-	void process (nano::secure::transaction const &, request_type const &, std::shared_ptr<nano::transport::channel> const &);
+
+	/** Ledger state of a requested hash and root, shared by every request for it in a batch */
+	struct resolution
+	{
+		/** Same root blocks that already have a final vote */
+		std::vector<std::shared_ptr<nano::block>> final_blocks;
+		/** Block found by final vote, hash or root, null if unknown */
+		std::shared_ptr<nano::block> block;
+		bool final{ false };
+	};
+	using resolutions_t = std::map<std::pair<nano::block_hash, nano::root>, resolution>;
+
+	/** Blocks and confirmation heights already read while resolving a batch */
+	struct lookup_cache
+	{
+		std::unordered_map<nano::block_hash, std::shared_ptr<nano::block>> blocks;
+		std::unordered_map<nano::account, uint64_t> heights;
+	};
+
+	/** Resolves every distinct hash and root requested in a batch with a single ledger lookup each, in sorted order **/
+	resolutions_t resolve (nano::secure::read_transaction &, std::vector<std::pair<nano::block_hash, nano::root>> keys) const;
+	resolution resolve (nano::secure::transaction const &, nano::block_hash const &, nano::root const &, lookup_cache &) const;
+	std::shared_ptr<nano::block> block_get (nano::secure::transaction const &, nano::block_hash const &, lookup_cache &) const;
+	bool confirmed (nano::secure::transaction const &, nano::block const &, lookup_cache &) const;
+
+	void process (resolutions_t const &, request_type const &, std::shared_ptr<nano::transport::channel> const &);
 
 	/** Remove duplicate requests **/
 	void erase_duplicates (std::vector<std::pair<nano::block_hash, nano::root>> &) const;
@@ -77,10 +103,10 @@ private:
 		std::vector<std::shared_ptr<nano::block>> remaining_final;
 	};
 
-	/** Aggregate \p requests_a and send cached votes to \p channel_a . Return the remaining hashes that need vote generation for each block for regular & final vote generators **/
-	aggregate_result aggregate (nano::secure::transaction const &, request_type const &, std::shared_ptr<nano::transport::channel> const &) const;
+	/** Aggregate \p requests_a from resolved ledger state. Return the remaining hashes that need vote generation for each block for regular & final vote generators **/
+	aggregate_result aggregate (resolutions_t const &, request_type const &) const;
 
-	void reply_action (std::shared_ptr<nano::vote> const & vote_a, std::shared_ptr<nano::transport::channel> const & channel_a) const;
+	void reply_action (std::shared_ptr<nano::vote> const & vote_a, nano::shared_const_buffer const & buffer_a, std::shared_ptr<nano::transport::channel> const & channel_a) const;
 
 private: // Dependencies
 	request_aggregator_config const & config;
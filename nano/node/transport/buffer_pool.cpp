@@ -0,0 +1,60 @@
+#include <nano/node/transport/buffer_pool.hpp>
+
+nano::transport::buffer_pool::buffer_pool (std::size_t buffer_size_a, std::size_t max_cached_a, nano::stats & stats_a) :
+	buffer_size{ buffer_size_a },
+	max_cached{ max_cached_a },
+	stats{ stats_a }
+{
+}
+
+auto nano::transport::buffer_pool::acquire () -> buffer_t
+{
+	buffer_t result;
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		if (!buffers.empty ())
+		{
+			result = std::move (buffers.back ());
+			buffers.pop_back ();
+		}
+	}
+	if (result)
+	{
+		stats.inc (nano::stat::type::buffer_pool, nano::stat::detail::reuse);
+		// Readers may have shrunk the buffer, capacity is kept so this does not reallocate
+		result->resize (buffer_size);
+	}
+	else
+	{
+		stats.inc (nano::stat::type::buffer_pool, nano::stat::detail::allocate);
+		result = std::make_shared<std::vector<uint8_t>> (buffer_size);
+	}
+	return result;
+}
+
+void nano::transport::buffer_pool::release (buffer_t buffer)
+{
+	debug_assert (buffer != nullptr);
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		if (buffers.size () < max_cached)
+		{
+			buffers.push_back (std::move (buffer));
+			return;
+		}
+	}
+	stats.inc (nano::stat::type::buffer_pool, nano::stat::detail::discard);
+}
+
+std::size_t nano::transport::buffer_pool::size () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return buffers.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::transport::buffer_pool::collect_container_info (std::string const & name) const
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "buffers", size (), buffer_size }));
+	return composite;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nano::transport
+{
+/**
+ * Pool of fixed size receive buffers, reused across reads so that inbound messages do not allocate a new buffer each time
+ * Buffers are only held while a message payload is being read and deserialized
+ */
+class buffer_pool final
+{
+public:
+	using buffer_t = std::shared_ptr<std::vector<uint8_t>>;
+
+public:
+	buffer_pool (std::size_t buffer_size, std::size_t max_cached, nano::stats &);
+
+	/** Returns a buffer of `buffer_size` bytes, either cached or newly allocated */
+	buffer_t acquire ();
+	/** Returns the buffer to the pool, it is discarded if the pool is full. Must only be called once no operation writes to the buffer anymore */
+	void release (buffer_t);
+
+	std::size_t size () const;
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
+	std::size_t const buffer_size;
+	std::size_t const max_cached;
+
+private: // Dependencies
+	nano::stats & stats;
+
+private:
+	std::vector<buffer_t> buffers;
+	mutable nano::mutex mutex;
+};
+}
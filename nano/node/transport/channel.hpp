@@ -31,6 +31,16 @@ public:
 	nano::transport::buffer_drop_policy policy_a = nano::transport::buffer_drop_policy::limiter,
 	nano::transport::traffic_type = nano::transport::traffic_type::generic);
 
+	/**
+	 * Sends a message already serialized with `to_shared_const_buffer ()`
+	 * The buffer is immutable so it can be shared when the same message goes out to many channels
+	 */
+	void send (nano::message const & message_a,
+	nano::shared_const_buffer const & buffer_a,
+	std::function<void (boost::system::error_code const &, std::size_t)> const & callback_a = nullptr,
+	nano::transport::buffer_drop_policy policy_a = nano::transport::buffer_drop_policy::limiter,
+	nano::transport::traffic_type = nano::transport::traffic_type::generic);
+
 	// TODO: investigate clang-tidy warning about default parameters on virtual/override functions
 	virtual void send_buffer (nano::shared_const_buffer const &,
 	std::function<void (boost::system::error_code const &, std::size_t)> const & = nullptr,
@@ -56,6 +66,12 @@ public:
 		return true;
 	}
 
+	/** Writes are delayed by the outbound shaper instead of being dropped by the bandwidth limiter */
+	virtual bool shaped () const
+	{
+		return false;
+	}
+
 	std::chrono::steady_clock::time_point get_last_bootstrap_attempt () const
 	{
 		nano::lock_guard<nano::mutex> lk (channel_mutex);
@@ -0,0 +1,61 @@
+#include <nano/lib/thread_runner.hpp>
+#include <nano/node/transport/io_pool.hpp>
+
+#include <algorithm>
+
+nano::transport::io_pool::io_pool (std::size_t count_a, std::shared_ptr<boost::asio::io_context> shared_a, nano::logger & logger_a) :
+	shared{ std::move (shared_a) },
+	logger{ logger_a }
+{
+	for (std::size_t n = 0; n < count_a; ++n)
+	{
+		auto context = std::make_shared<boost::asio::io_context> (1); // Concurrency hint, a single thread runs each context
+		runners.push_back (std::make_unique<nano::thread_runner> (context, logger, 1, nano::thread_role::name::io_pinned));
+		contexts.push_back (std::move (context));
+	}
+}
+
+nano::transport::io_pool::~io_pool ()
+{
+	// Thread runners join when destroyed, before the contexts they run
+}
+
+void nano::transport::io_pool::stop ()
+{
+	for (auto & runner : runners)
+	{
+		runner->join ();
+	}
+}
+
+boost::asio::io_context & nano::transport::io_pool::next ()
+{
+	if (contexts.empty ())
+	{
+		return *shared;
+	}
+	return *contexts[counter++ % contexts.size ()];
+}
+
+std::shared_ptr<boost::asio::io_context> nano::transport::io_pool::owner (boost::asio::io_context const & context_a) const
+{
+	auto existing = std::find_if (contexts.begin (), contexts.end (), [&context_a] (auto const & context) { return context.get () == &context_a; });
+	if (existing != contexts.end ())
+	{
+		return *existing;
+	}
+	debug_assert (shared.get () == &context_a);
+	return shared;
+}
+
+std::size_t nano::transport::io_pool::size () const
+{
+	return contexts.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::transport::io_pool::collect_container_info (std::string const & name) const
+{
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "contexts", contexts.size (), sizeof (boost::asio::io_context) }));
+	return composite;
+}
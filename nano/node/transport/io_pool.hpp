@@ -0,0 +1,51 @@
+#pragma once
+
+#include <nano/boost/asio/io_context.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace nano
+{
+class thread_runner;
+}
+
+namespace nano::transport
+{
+/**
+ * Set of independent io_contexts, each run by a single thread, that peer sockets are pinned to for their whole lifetime
+ * All completion handlers of a socket then execute on the same thread, which keeps its state in one core's cache and avoids contention on strands
+ * With no pinned contexts every socket uses the shared node io_context
+ * Sockets can outlive the node, so each of them shares ownership of the context its strand is bound to
+ */
+class io_pool final
+{
+public:
+	io_pool (std::size_t count, std::shared_ptr<boost::asio::io_context> shared, nano::logger &);
+	~io_pool ();
+
+	/** Waits for the pinned threads to finish, sockets using them must be closed beforehand */
+	void stop ();
+
+	/** Context a new socket should be opened on, pinned contexts are assigned round robin */
+	boost::asio::io_context & next ();
+	/** Owning pointer of a context handed out by next () */
+	std::shared_ptr<boost::asio::io_context> owner (boost::asio::io_context const &) const;
+
+	/** Number of pinned contexts, zero when sockets use the shared io_context */
+	std::size_t size () const;
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
+private: // Dependencies
+	std::shared_ptr<boost::asio::io_context> shared;
+	nano::logger & logger;
+
+private:
+	std::vector<std::shared_ptr<boost::asio::io_context>> contexts;
+	std::vector<std::unique_ptr<nano::thread_runner>> runners;
+	std::atomic<std::size_t> counter{ 0 };
+};
+}
@@ -3,16 +3,17 @@
 #include <nano/node/transport/message_deserializer.hpp>
 
 nano::transport::message_deserializer::message_deserializer (nano::network_constants const & network_constants_a, nano::network_filter & network_filter_a, nano::block_uniquer & block_uniquer_a, nano::vote_uniquer & vote_uniquer_a,
-read_query read_op) :
-	read_buffer{ std::make_shared<std::vector<uint8_t>> () },
+nano::transport::buffer_pool & buffer_pool_a, read_query read_op) :
+	header_buffer{ std::make_shared<std::vector<uint8_t>> (HEADER_SIZE) },
 	network_constants_m{ network_constants_a },
 	network_filter_m{ network_filter_a },
 	block_uniquer_m{ block_uniquer_a },
 	vote_uniquer_m{ vote_uniquer_a },
+	buffer_pool_m{ buffer_pool_a },
 	read_op{ std::move (read_op) }
 {
 	debug_assert (this->read_op);
-	read_buffer->resize (MAX_MESSAGE_SIZE);
+	debug_assert (buffer_pool_m.buffer_size >= MAX_MESSAGE_SIZE);
 }
 
 void nano::transport::message_deserializer::read (const nano::transport::message_deserializer::callback_type && callback)
@@ -22,7 +23,7 @@ void nano::transport::message_deserializer::read (const nano::transport::message
 
 	status = parse_status::none;
 
-	read_op (read_buffer, HEADER_SIZE, [this_l = shared_from_this (), callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
+	read_op (header_buffer, HEADER_SIZE, [this_l = shared_from_this (), callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
 		if (ec)
 		{
 			callback (ec, nullptr);
@@ -39,7 +40,7 @@ void nano::transport::message_deserializer::read (const nano::transport::message
 
 void nano::transport::message_deserializer::received_header (const nano::transport::message_deserializer::callback_type && callback)
 {
-	nano::bufferstream stream{ read_buffer->data (), HEADER_SIZE };
+	nano::bufferstream stream{ header_buffer->data (), HEADER_SIZE };
 	auto error = false;
 	nano::message_header header{ error, stream };
 	if (error)
@@ -74,7 +75,6 @@ void nano::transport::message_deserializer::received_header (const nano::transpo
 		callback (boost::asio::error::fault, nullptr);
 		return;
 	}
-	debug_assert (payload_size <= read_buffer->capacity ());
 
 	if (payload_size == 0)
 	{
@@ -84,14 +84,19 @@ void nano::transport::message_deserializer::received_header (const nano::transpo
 	else
 	{
 		debug_assert (read_op);
+		debug_assert (read_buffer == nullptr);
+		read_buffer = buffer_pool_m.acquire ();
+		debug_assert (payload_size <= read_buffer->size ());
 		read_op (read_buffer, payload_size, [this_l = shared_from_this (), payload_size, header, callback = std::move (callback)] (boost::system::error_code const & ec, std::size_t size_a) {
 			if (ec)
 			{
+				this_l->release_buffer ();
 				callback (ec, nullptr);
 				return;
 			}
 			if (size_a != payload_size)
 			{
+				this_l->release_buffer ();
 				callback (boost::asio::error::fault, nullptr);
 				return;
 			}
@@ -103,6 +108,7 @@ void nano::transport::message_deserializer::received_header (const nano::transpo
 void nano::transport::message_deserializer::received_message (nano::message_header header, std::size_t payload_size, const nano::transport::message_deserializer::callback_type && callback)
 {
 	auto message = deserialize (header, payload_size);
+	release_buffer ();
 	if (message)
 	{
 		debug_assert (status == parse_status::none);
@@ -116,10 +122,21 @@ void nano::transport::message_deserializer::received_message (nano::message_head
 	}
 }
 
+void nano::transport::message_deserializer::release_buffer ()
+{
+	if (read_buffer)
+	{
+		buffer_pool_m.release (std::move (read_buffer));
+		read_buffer = nullptr;
+	}
+}
+
 std::unique_ptr<nano::message> nano::transport::message_deserializer::deserialize (nano::message_header header, std::size_t payload_size)
 {
 	release_assert (payload_size <= MAX_MESSAGE_SIZE);
-	nano::bufferstream stream{ read_buffer->data (), payload_size };
+	// Messages without a payload never take a buffer from the pool
+	uint8_t const * data = read_buffer ? read_buffer->data () : header_buffer->data ();
+	nano::bufferstream stream{ data, payload_size };
 	switch (header.type)
 	{
 		case nano::message_type::keepalive:
@@ -130,7 +147,7 @@ std::unique_ptr<nano::message> nano::transport::message_deserializer::deserializ
 		{
 			// Early filtering to not waste time deserializing duplicates
 			nano::uint128_t digest;
-			if (!network_filter_m.apply (read_buffer->data (), payload_size, &digest))
+			if (!network_filter_m.apply (data, payload_size, &digest))
 			{
 				return deserialize_publish (stream, header, digest);
 			}
@@ -148,7 +165,7 @@ std::unique_ptr<nano::message> nano::transport::message_deserializer::deserializ
 		{
 			// Early filtering to not waste time deserializing duplicates
 			nano::uint128_t digest;
-			if (!network_filter_m.apply (read_buffer->data (), payload_size, &digest))
+			if (!network_filter_m.apply (data, payload_size, &digest))
 			{
 				return deserialize_confirm_ack (stream, header, digest);
 			}
@@ -3,6 +3,7 @@
 #include <nano/lib/network_filter.hpp>
 #include <nano/node/common.hpp>
 #include <nano/node/messages.hpp>
+#include <nano/node/transport/buffer_pool.hpp>
 
 #include <memory>
 #include <vector>
@@ -46,7 +47,7 @@ namespace transport
 
 		using read_query = std::function<void (std::shared_ptr<std::vector<uint8_t>> const &, size_t, std::function<void (boost::system::error_code const &, std::size_t)>)>;
 
-		message_deserializer (nano::network_constants const &, nano::network_filter &, nano::block_uniquer &, nano::vote_uniquer &, read_query read_op);
+		message_deserializer (nano::network_constants const &, nano::network_filter &, nano::block_uniquer &, nano::vote_uniquer &, nano::transport::buffer_pool &, read_query read_op);
 
 		/*
 		 * Asynchronously read next message from the channel_read_fn.
@@ -80,10 +81,15 @@ namespace transport
 		std::unique_ptr<nano::asc_pull_req> deserialize_asc_pull_req (nano::stream &, nano::message_header const &);
 		std::unique_ptr<nano::asc_pull_ack> deserialize_asc_pull_ack (nano::stream &, nano::message_header const &);
 
+		/** Hands the payload buffer back to the pool once its contents are no longer needed */
+		void release_buffer ();
+
 	private:
-		std::shared_ptr<std::vector<uint8_t>> read_buffer;
+		std::shared_ptr<std::vector<uint8_t>> header_buffer;
+		/** Taken from the pool only while a payload is being read and deserialized */
+		nano::transport::buffer_pool::buffer_t read_buffer;
 
-	private: // Constants
+	public: // Constants
 		static constexpr std::size_t HEADER_SIZE = 8;
 		static constexpr std::size_t MAX_MESSAGE_SIZE = 1024 * 65;
 
@@ -92,6 +98,7 @@ namespace transport
 		nano::network_filter & network_filter_m;
 		nano::block_uniquer & block_uniquer_m;
 		nano::vote_uniquer & vote_uniquer_m;
+		nano::transport::buffer_pool & buffer_pool_m;
 		read_query read_op;
 	};
 
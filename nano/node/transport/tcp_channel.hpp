@@ -65,6 +65,11 @@ public:
 		return false;
 	}
 
+	bool shaped () const override
+	{
+		return true;
+	}
+
 	void close () override
 	{
 		if (auto socket_l = socket.lock ())
@@ -48,6 +48,43 @@ void nano::transport::tcp_channels::close ()
 	}
 
 	channels.clear ();
+	update_snapshot ();
+}
+
+void nano::transport::tcp_channels::update_snapshot ()
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto result = std::make_shared<snapshot> ();
+	result->channels.reserve (channels.size ());
+	result->by_endpoint.reserve (channels.size ());
+	result->by_node_id.reserve (channels.size ());
+	for (auto const & entry : channels.get<random_access_tag> ())
+	{
+		result->channels.push_back (entry.channel);
+		result->by_endpoint.emplace (entry.endpoint (), entry.channel);
+		result->by_node_id.emplace (entry.node_id (), entry.channel);
+	}
+#ifdef __cpp_lib_atomic_shared_ptr
+	snapshot_m.store (std::move (result));
+#else
+	std::shared_ptr<snapshot const> previous{ std::move (result) };
+	{
+		nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+		snapshot_m.swap (previous);
+	}
+	// The previous snapshot is released outside of the lock
+#endif
+}
+
+auto nano::transport::tcp_channels::current () const -> std::shared_ptr<snapshot const>
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+	return snapshot_m.load ();
+#else
+	nano::lock_guard<nano::mutex> guard{ snapshot_mutex };
+	return snapshot_m;
+#endif
 }
 
 bool nano::transport::tcp_channels::check (const nano::tcp_endpoint & endpoint, const nano::account & node_id) const
@@ -125,6 +162,7 @@ std::shared_ptr<nano::transport::tcp_channel> nano::transport::tcp_channels::cre
 
 	auto [_, inserted] = channels.get<endpoint_tag> ().emplace (channel, socket, server);
 	debug_assert (inserted);
+	update_snapshot ();
 
 	lock.unlock ();
 
@@ -136,42 +174,48 @@ std::shared_ptr<nano::transport::tcp_channel> nano::transport::tcp_channels::cre
 void nano::transport::tcp_channels::erase (nano::tcp_endpoint const & endpoint_a)
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
-	channels.get<endpoint_tag> ().erase (endpoint_a);
+	if (channels.get<endpoint_tag> ().erase (endpoint_a) > 0)
+	{
+		update_snapshot ();
+	}
 }
 
 std::size_t nano::transport::tcp_channels::size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return channels.size ();
+	return current ()->channels.size ();
 }
 
 std::shared_ptr<nano::transport::tcp_channel> nano::transport::tcp_channels::find_channel (nano::tcp_endpoint const & endpoint_a) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const snapshot_l = current ();
 	std::shared_ptr<nano::transport::tcp_channel> result;
-	auto existing (channels.get<endpoint_tag> ().find (endpoint_a));
-	if (existing != channels.get<endpoint_tag> ().end ())
+	auto existing (snapshot_l->by_endpoint.find (endpoint_a));
+	if (existing != snapshot_l->by_endpoint.end ())
 	{
-		result = existing->channel;
+		result = existing->second;
 	}
 	return result;
 }
 
 std::unordered_set<std::shared_ptr<nano::transport::channel>> nano::transport::tcp_channels::random_set (std::size_t count_a, uint8_t min_version, bool include_temporary_channels_a) const
 {
+	// Called for every flood from many threads, sample from the snapshot with a per thread generator
+	static thread_local nano::random_generator rng_l;
+
 	std::unordered_set<std::shared_ptr<nano::transport::channel>> result;
 	result.reserve (count_a);
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto const snapshot_l = current ();
+	auto const & channels_l = snapshot_l->channels;
 	// Stop trying to fill result with random samples after this many attempts
 	auto random_cutoff (count_a * 2);
 	// Usually count_a will be much smaller than peers.size()
 	// Otherwise make sure we have a cutoff on attempting to randomly fill
-	if (!channels.empty ())
+	if (!channels_l.empty ())
 	{
 		for (auto i (0); i < random_cutoff && result.size () < count_a; ++i)
 		{
-			auto index = rng.random (channels.size ());
-			auto channel = channels.get<random_access_tag> ()[index].channel;
+			auto index = rng_l.random (channels_l.size ());
+			auto const & channel = channels_l[index];
 			if (!channel->alive ())
 			{
 				continue;
@@ -204,12 +248,12 @@ void nano::transport::tcp_channels::random_fill (std::array<nano::endpoint, 8> &
 
 std::shared_ptr<nano::transport::tcp_channel> nano::transport::tcp_channels::find_node_id (nano::account const & node_id_a)
 {
+	auto const snapshot_l = current ();
 	std::shared_ptr<nano::transport::tcp_channel> result;
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	auto existing (channels.get<node_id_tag> ().find (node_id_a));
-	if (existing != channels.get<node_id_tag> ().end ())
+	auto existing (snapshot_l->by_node_id.find (node_id_a));
+	if (existing != snapshot_l->by_node_id.end ())
 	{
-		result = existing->channel;
+		result = existing->second;
 	}
 	return result;
 }
@@ -363,6 +407,7 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 		}
 	}
 
+	auto const size_before = channels.size ();
 	erase_if (channels, [this] (auto const & entry) {
 		if (!entry.channel->alive ())
 		{
@@ -371,6 +416,10 @@ void nano::transport::tcp_channels::purge (std::chrono::steady_clock::time_point
 		}
 		return false;
 	});
+	if (channels.size () != size_before)
+	{
+		update_snapshot ();
+	}
 
 	// Remove keepalive attempt tracking for attempts older than cutoff
 	auto attempts_cutoff (attempts.get<last_attempt_tag> ().lower_bound (cutoff_deadline));
@@ -382,22 +431,18 @@ void nano::transport::tcp_channels::keepalive ()
 	nano::keepalive message{ node.network_params.network };
 	node.network.random_fill (message.peers);
 
-	nano::unique_lock<nano::mutex> lock{ mutex };
-
 	auto const cutoff_time = std::chrono::steady_clock::now () - node.network_params.network.keepalive_period;
 
 	// Wake up channels
 	std::vector<std::shared_ptr<nano::transport::tcp_channel>> to_wakeup;
-	for (auto const & entry : channels)
+	for (auto const & channel : current ()->channels)
 	{
-		if (entry.channel->get_last_packet_sent () < cutoff_time)
+		if (channel->get_last_packet_sent () < cutoff_time)
 		{
-			to_wakeup.push_back (entry.channel);
+			to_wakeup.push_back (channel);
 		}
 	}
 
-	lock.unlock ();
-
 	for (auto & channel : to_wakeup)
 	{
 		channel->send (message);
@@ -426,12 +471,10 @@ std::optional<nano::keepalive> nano::transport::tcp_channels::sample_keepalive (
 
 void nano::transport::tcp_channels::list (std::deque<std::shared_ptr<nano::transport::channel>> & deque_a, uint8_t minimum_version_a, bool include_temporary_channels_a)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	// clang-format off
-	nano::transform_if (channels.get<random_access_tag> ().begin (), channels.get<random_access_tag> ().end (), std::back_inserter (deque_a),
-		[include_temporary_channels_a, minimum_version_a](auto & channel_a) { return channel_a.channel->get_network_version () >= minimum_version_a; },
-		[](auto const & channel) { return channel.channel; });
-	// clang-format on
+	auto const snapshot_l = current ();
+	std::copy_if (snapshot_l->channels.begin (), snapshot_l->channels.end (), std::back_inserter (deque_a), [minimum_version_a] (auto const & channel) {
+		return channel->get_network_version () >= minimum_version_a;
+	});
 }
 
 void nano::transport::tcp_channels::modify (std::shared_ptr<nano::transport::tcp_channel> const & channel_a, std::function<void (std::shared_ptr<nano::transport::tcp_channel> const &)> modify_callback_a)
@@ -443,6 +486,8 @@ void nano::transport::tcp_channels::modify (std::shared_ptr<nano::transport::tcp
 		channels.get<endpoint_tag> ().modify (existing, [modify_callback = std::move (modify_callback_a)] (channel_entry & wrapper_a) {
 			modify_callback (wrapper_a.channel);
 		});
+		// The callback may change indexed properties such as the node id
+		update_snapshot ();
 	}
 }
 
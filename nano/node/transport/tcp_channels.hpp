@@ -13,9 +13,13 @@
 #include <boost/multi_index/random_access_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
+#include <memory>
 #include <random>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -58,12 +62,29 @@ public:
 	// Connection start
 	void start_tcp (nano::endpoint const &);
 
+public:
+	/**
+	 * Immutable copy of the channel set used by the broadcast and lookup paths.
+	 * It is rebuilt and swapped in whenever channels are added or removed, so readers never take the channels mutex.
+	 */
+	class snapshot final
+	{
+	public:
+		std::vector<std::shared_ptr<nano::transport::tcp_channel>> channels;
+		std::unordered_map<nano::tcp_endpoint, std::shared_ptr<nano::transport::tcp_channel>> by_endpoint;
+		std::unordered_map<nano::account, std::shared_ptr<nano::transport::tcp_channel>> by_node_id;
+	};
+
+	std::shared_ptr<snapshot const> current () const;
+
 private: // Dependencies
 	nano::node & node;
 
 private:
 	void close ();
 	bool check (nano::tcp_endpoint const &, nano::account const & node_id) const;
+	/** Publishes a new snapshot of the channel set, must be called with the mutex held after every change to `channels` */
+	void update_snapshot ();
 
 private:
 	class channel_entry final
@@ -168,6 +189,14 @@ private:
 	nano::condition_variable condition;
 	mutable nano::mutex mutex;
 
+#ifdef __cpp_lib_atomic_shared_ptr
+	std::atomic<std::shared_ptr<snapshot const>> snapshot_m{ std::make_shared<snapshot const> () };
+#else
+	// Standard libraries without atomic shared_ptr, guards only the pointer swap
+	mutable nano::mutex snapshot_mutex;
+	std::shared_ptr<snapshot const> snapshot_m{ std::make_shared<snapshot const> () };
+#endif
+
 	mutable nano::random_generator rng;
 };
 }
\ No newline at end of file
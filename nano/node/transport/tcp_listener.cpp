@@ -1,7 +1,9 @@
 #include <nano/lib/enum_util.hpp>
 #include <nano/lib/interval.hpp>
+#include <nano/lib/tomlconfig.hpp>
 #include <nano/node/messages.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/transport/io_pool.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_server.hpp>
 
@@ -341,14 +343,16 @@ asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::accept_soc
 {
 	debug_assert (strand.running_in_this_thread ());
 
-	co_return co_await acceptor.async_accept (asio::use_awaitable);
+	// Accepted sockets are opened directly on the context they stay pinned to
+	auto socket = co_await acceptor.async_accept (node.io_pool.next (), asio::use_awaitable);
+	co_return asio::ip::tcp::socket{ std::move (socket) };
 }
 
 asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::connect_socket (asio::ip::tcp::endpoint endpoint)
 {
 	debug_assert (strand.running_in_this_thread ());
 
-	asio::ip::tcp::socket raw_socket{ strand };
+	asio::ip::tcp::socket raw_socket{ node.io_pool.next () };
 	co_await raw_socket.async_connect (endpoint, asio::use_awaitable);
 
 	co_return raw_socket;
@@ -643,3 +647,35 @@ nano::transport::socket_endpoint nano::transport::tcp_listener::to_socket_endpoi
 	debug_assert (false);
 	return {};
 }
+
+/*
+ * tcp_config
+ */
+
+nano::error nano::transport::tcp_config::serialize (nano::tomlconfig & toml) const
+{
+	toml.put ("max_inbound_connections", max_inbound_connections, "Maximum number of incoming TCP connections. \ntype:uint64");
+	toml.put ("max_outbound_connections", max_outbound_connections, "Maximum number of outgoing TCP connections. \ntype:uint64");
+	toml.put ("max_attempts", max_attempts, "Maximum connection attempts. \ntype:uint64");
+	toml.put ("max_attempts_per_ip", max_attempts_per_ip, "Maximum connection attempts per IP. \ntype:uint64");
+	toml.put ("connect_timeout", connect_timeout.count (), "Timeout for establishing TCP connections in seconds. \ntype:uint64");
+	toml.put ("max_write_batch_bytes", max_write_batch_bytes, "Upper bound of bytes drained from a socket send queue into a single write. \ntype:uint64");
+
+	return toml.get_error ();
+}
+
+nano::error nano::transport::tcp_config::deserialize (nano::tomlconfig & toml)
+{
+	toml.get ("max_inbound_connections", max_inbound_connections);
+	toml.get ("max_outbound_connections", max_outbound_connections);
+	toml.get ("max_attempts", max_attempts);
+	toml.get ("max_attempts_per_ip", max_attempts_per_ip);
+
+	auto connect_timeout_l = connect_timeout.count ();
+	toml.get ("connect_timeout", connect_timeout_l);
+	connect_timeout = std::chrono::seconds{ connect_timeout_l };
+
+	toml.get ("max_write_batch_bytes", max_write_batch_bytes);
+
+	return toml.get_error ();
+}
@@ -40,12 +40,17 @@ public:
 		}
 	}
 
+	nano::error deserialize (nano::tomlconfig & toml);
+	nano::error serialize (nano::tomlconfig & toml) const;
+
 public:
 	size_t max_inbound_connections{ 2048 };
 	size_t max_outbound_connections{ 2048 };
 	size_t max_attempts{ 60 };
 	size_t max_attempts_per_ip{ 1 };
 	std::chrono::seconds connect_timeout{ 60 };
+	/** Upper bound of bytes drained from the send queue into a single vectored socket write */
+	size_t max_write_batch_bytes{ 64 * 1024 };
 };
 
 /**
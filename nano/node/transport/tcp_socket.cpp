@@ -1,7 +1,9 @@
 #include <nano/boost/asio/bind_executor.hpp>
 #include <nano/boost/asio/read.hpp>
 #include <nano/lib/enum_util.hpp>
+#include <nano/node/bandwidth_limiter.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/transport/io_pool.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 #include <nano/node/transport/transport.hpp>
 
@@ -14,19 +16,36 @@
 #include <memory>
 #include <utility>
 
+namespace
+{
+// The strand has to run on the io_context the socket was opened on, which is the pinned context when an io_pool is used
+boost::asio::io_context::executor_type socket_executor (boost::asio::ip::tcp::socket & socket)
+{
+	auto executor = socket.get_executor ();
+	if (auto strand_executor = executor.target<boost::asio::strand<boost::asio::io_context::executor_type>> ())
+	{
+		return strand_executor->get_inner_executor ();
+	}
+	auto context_executor = executor.target<boost::asio::io_context::executor_type> ();
+	release_assert (context_executor != nullptr, "socket must be opened on an io_context");
+	return *context_executor;
+}
+}
+
 /*
  * socket
  */
 
 nano::transport::tcp_socket::tcp_socket (nano::node & node_a, nano::transport::socket_endpoint endpoint_type_a, std::size_t max_queue_size_a) :
-	tcp_socket{ node_a, boost::asio::ip::tcp::socket{ node_a.io_ctx }, {}, {}, endpoint_type_a, max_queue_size_a }
+	tcp_socket{ node_a, boost::asio::ip::tcp::socket{ node_a.io_pool.next () }, {}, {}, endpoint_type_a, max_queue_size_a }
 {
 }
 
 nano::transport::tcp_socket::tcp_socket (nano::node & node_a, boost::asio::ip::tcp::socket raw_socket_a, boost::asio::ip::tcp::endpoint remote_endpoint_a, boost::asio::ip::tcp::endpoint local_endpoint_a, nano::transport::socket_endpoint endpoint_type_a, std::size_t max_queue_size_a) :
 	send_queue{ max_queue_size_a },
 	node_w{ node_a.shared () },
-	strand{ node_a.io_ctx.get_executor () },
+	context{ node_a.io_pool.owner (socket_executor (raw_socket_a).context ()) },
+	strand{ socket_executor (raw_socket_a) },
 	raw_socket{ std::move (raw_socket_a) },
 	remote{ remote_endpoint_a },
 	local{ local_endpoint_a },
@@ -36,7 +55,8 @@ nano::transport::tcp_socket::tcp_socket (nano::node & node_a, boost::asio::ip::t
 	last_receive_time_or_init{ nano::seconds_since_epoch () },
 	default_timeout{ node_a.config.tcp_io_timeout },
 	silent_connection_tolerance_time{ node_a.network_params.network.silent_connection_tolerance_time },
-	max_queue_size{ max_queue_size_a }
+	max_queue_size{ max_queue_size_a },
+	max_write_batch_bytes{ node_a.config.tcp.max_write_batch_bytes }
 {
 }
 
@@ -186,17 +206,68 @@ void nano::transport::tcp_socket::write_queued_messages ()
 		return;
 	}
 
-	auto next = send_queue.pop ();
-	if (!next)
+	// Coalesce several queued messages into a single scatter/gather write to save syscalls and strand hops
+	auto batch = std::make_shared<std::vector<socket_queue::entry>> (send_queue.pop_batch (max_write_batch_bytes));
+	if (batch->empty ())
 	{
 		return;
 	}
 
-	set_default_timeout ();
+	auto node_l = node_w.lock ();
+	if (!node_l)
+	{
+		// Already popped from the queue, senders still expect a completion
+		abort_batch (*batch, boost::asio::error::operation_aborted);
+		return;
+	}
+
+	std::size_t size = 0;
+	for (auto const & entry : *batch)
+	{
+		size += entry.buffer.size ();
+	}
 
+	// Once the bandwidth budget is used up the write waits for its turn in the outbound shaper, later messages stay queued behind it
 	write_in_progress = true;
-	nano::async_write (raw_socket, next->buffer,
-	boost::asio::bind_executor (strand, [this_l = shared_from_this (), next /* `next` object keeps buffer in scope */] (boost::system::error_code ec, std::size_t size) {
+	auto const granted = node_l->outbound_limiter.acquire (size, batch->front ().type, [this_w = weak_from_this (), batch] () {
+		if (auto this_l = this_w.lock ())
+		{
+			boost::asio::post (this_l->strand, [this_l, batch] () {
+				this_l->write_batch (batch);
+			});
+		}
+	});
+	if (granted)
+	{
+		write_batch (std::move (batch));
+	}
+}
+
+// Must be called from strand
+void nano::transport::tcp_socket::write_batch (std::shared_ptr<std::vector<socket_queue::entry>> batch)
+{
+	debug_assert (strand.running_in_this_thread ());
+	debug_assert (write_in_progress);
+
+	if (closed)
+	{
+		// Closed while waiting in the outbound shaper
+		write_in_progress = false;
+		abort_batch (*batch, boost::asio::error::operation_aborted);
+		return;
+	}
+
+	std::vector<boost::asio::const_buffer> buffers;
+	buffers.reserve (batch->size ());
+	for (auto const & entry : *batch)
+	{
+		buffers.insert (buffers.end (), entry.buffer.begin (), entry.buffer.end ());
+	}
+
+	set_default_timeout ();
+
+	nano::unsafe_async_write (raw_socket, buffers,
+	boost::asio::bind_executor (strand, [this_l = shared_from_this (), batch = std::move (batch) /* `batch` keeps buffers in scope */] (boost::system::error_code ec, std::size_t size) {
 		debug_assert (this_l->strand.running_in_this_thread ());
 
 		auto node_l = this_l->node_w.lock ();
@@ -214,12 +285,21 @@ void nano::transport::tcp_socket::write_queued_messages ()
 		else
 		{
 			node_l->stats.add (nano::stat::type::traffic_tcp, nano::stat::detail::all, nano::stat::dir::out, size, /* aggregate all */ true);
+			node_l->stats.inc (nano::stat::type::tcp, nano::stat::detail::tcp_write_batch, nano::stat::dir::out);
+			node_l->stats.add (nano::stat::type::tcp, nano::stat::detail::tcp_write_coalesced, nano::stat::dir::out, batch->size () - 1);
 			this_l->set_last_completion ();
 		}
 
-		if (next->callback)
+		// Each entry is completed with the part of the transferred bytes that belongs to it
+		auto remaining = size;
+		for (auto const & entry : *batch)
 		{
-			next->callback (ec, size);
+			auto const written = std::min (remaining, entry.buffer.size ());
+			remaining -= written;
+			if (entry.callback)
+			{
+				entry.callback (ec, written);
+			}
 		}
 
 		if (!ec)
@@ -229,6 +309,17 @@ void nano::transport::tcp_socket::write_queued_messages ()
 	}));
 }
 
+void nano::transport::tcp_socket::abort_batch (std::vector<socket_queue::entry> const & batch, boost::system::error_code const & ec)
+{
+	for (auto const & entry : batch)
+	{
+		if (entry.callback)
+		{
+			entry.callback (ec, 0);
+		}
+	}
+}
+
 bool nano::transport::tcp_socket::max (nano::transport::traffic_type traffic_type) const
 {
 	return send_queue.size (traffic_type) >= max_queue_size;
@@ -430,7 +521,7 @@ bool nano::transport::socket_queue::insert (const buffer_t & buffer, callback_t
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	if (queues[traffic_type].size () < 2 * max_size)
 	{
-		queues[traffic_type].push (entry{ buffer, callback });
+		queues[traffic_type].push (entry{ buffer, callback, traffic_type });
 		return true; // Queued
 	}
 	return false; // Not queued
@@ -464,6 +555,37 @@ std::optional<nano::transport::socket_queue::entry> nano::transport::socket_queu
 	return std::nullopt;
 }
 
+std::vector<nano::transport::socket_queue::entry> nano::transport::socket_queue::pop_batch (std::size_t max_bytes)
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+
+	std::vector<entry> result;
+	std::size_t bytes = 0;
+
+	// The batch is the same sequence `pop ()` would return, taken from the highest priority queue that has entries and cut before the first entry that does not fit
+	for (auto type : { nano::transport::traffic_type::generic, nano::transport::traffic_type::bootstrap })
+	{
+		auto & que = queues[type];
+		while (!que.empty ())
+		{
+			auto const size = que.front ().buffer.size ();
+			if (!result.empty () && bytes + size > max_bytes)
+			{
+				break;
+			}
+			bytes += size;
+			result.push_back (std::move (que.front ()));
+			que.pop ();
+		}
+		if (!result.empty ())
+		{
+			break;
+		}
+	}
+
+	return result;
+}
+
 void nano::transport::socket_queue::clear ()
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
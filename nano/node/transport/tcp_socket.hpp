@@ -39,6 +39,7 @@ public:
 	{
 		buffer_t buffer;
 		callback_t callback;
+		nano::transport::traffic_type type;
 	};
 
 public:
@@ -46,6 +47,11 @@ public:
 
 	bool insert (buffer_t const &, callback_t, nano::transport::traffic_type);
 	std::optional<entry> pop ();
+	/**
+	 * Pops entries in priority order until adding the next one would exceed `max_bytes` or it has a different traffic type,
+	 * so the batch is charged to a single bandwidth budget. Always returns at least one entry if not empty
+	 */
+	std::vector<entry> pop_batch (std::size_t max_bytes);
 	void clear ();
 	std::size_t size (nano::transport::traffic_type) const;
 	bool empty () const;
@@ -146,6 +152,8 @@ private:
 protected:
 	std::weak_ptr<nano::node> node_w;
 
+	/** Keeps the io_context the strand and socket are bound to alive when the socket outlives the node */
+	std::shared_ptr<boost::asio::io_context> context;
 	boost::asio::strand<boost::asio::io_context::executor_type> strand;
 	boost::asio::ip::tcp::socket raw_socket;
 
@@ -188,6 +196,9 @@ protected:
 
 	void close_internal ();
 	void write_queued_messages ();
+	void write_batch (std::shared_ptr<std::vector<socket_queue::entry>> batch);
+	/** Completes every entry of a batch that will not be written with `ec` */
+	void abort_batch (std::vector<socket_queue::entry> const & batch, boost::system::error_code const & ec);
 	void set_default_timeout ();
 	void set_last_completion ();
 	void set_last_receive_time ();
@@ -200,6 +211,7 @@ private:
 
 public:
 	std::size_t const max_queue_size;
+	std::size_t const max_write_batch_bytes;
 
 public: // Logging
 	virtual void operator() (nano::object_stream &) const;
@@ -0,0 +1,41 @@
+#include <nano/node/vote_bundling.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+nano::vote_bundling_window::vote_bundling_window (std::chrono::milliseconds max_delay_a, std::size_t threshold_a, std::size_t bundle_max_a) :
+	max_delay{ std::max (max_delay_a, std::chrono::milliseconds{ 1 }) },
+	threshold{ threshold_a },
+	bundle_max{ bundle_max_a }
+{
+}
+
+void nano::vote_bundling_window::arrived (std::size_t count, std::chrono::steady_clock::time_point now)
+{
+	weight = rate (now) * std::chrono::duration<double> (max_delay).count () + count;
+	last = now;
+}
+
+double nano::vote_bundling_window::rate (std::chrono::steady_clock::time_point now) const
+{
+	auto const elapsed = std::chrono::duration<double> (std::max (now - last, std::chrono::steady_clock::duration::zero ()));
+	auto const tau = std::chrono::duration<double> (max_delay);
+	return weight * std::exp (-elapsed.count () / tau.count ()) / tau.count ();
+}
+
+std::chrono::milliseconds nano::vote_bundling_window::window (std::size_t pending, std::chrono::steady_clock::time_point now) const
+{
+	if (pending >= bundle_max)
+	{
+		return std::chrono::milliseconds{ 0 };
+	}
+	auto const rate_l = rate (now);
+	// Waiting the whole delay would not gather enough hashes to be worth the latency
+	if (pending + rate_l * std::chrono::duration<double> (max_delay).count () < threshold)
+	{
+		return std::chrono::milliseconds{ 0 };
+	}
+	// Clamped before converting, a rate near zero gives a fill time too large for milliseconds
+	auto const fill = std::min ((bundle_max - pending) / rate_l, std::chrono::duration<double> (max_delay).count ());
+	return std::chrono::ceil<std::chrono::milliseconds> (std::chrono::duration<double> (fill));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace nano
+{
+/**
+ * Sizes the time the vote generator waits for more candidates before broadcasting a vote.
+ * Tracks the candidate arrival rate and waits roughly as long as it takes to fill a full vote, bounded by the maximum delay.
+ * When even the maximum delay would not bundle a worthwhile number of hashes, votes are broadcast without waiting.
+ */
+class vote_bundling_window final
+{
+public:
+	vote_bundling_window (std::chrono::milliseconds max_delay, std::size_t threshold, std::size_t bundle_max);
+
+	/** Records candidates becoming available for voting */
+	void arrived (std::size_t count, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ());
+	/** How long to wait for more candidates when `pending` are already queued */
+	std::chrono::milliseconds window (std::size_t pending, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ()) const;
+	/** Estimated candidate arrival rate, per second */
+	double rate (std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ()) const;
+
+private:
+	std::chrono::milliseconds const max_delay;
+	std::size_t const threshold;
+	std::size_t const bundle_max;
+
+	/** Exponentially decayed count of arrivals, decaying with a time constant of max_delay */
+	double weight{ 0 };
+	std::chrono::steady_clock::time_point last{};
+};
+}
@@ -14,6 +14,7 @@
 #include <nano/store/component.hpp>
 
 #include <chrono>
+#include <unordered_map>
 
 nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::node & node_a, nano::ledger & ledger_a, nano::wallets & wallets_a, nano::vote_processor & vote_processor_a, nano::local_vote_history & history_a, nano::network & network_a, nano::stats & stats_a, nano::logger & logger_a, bool is_final_a) :
 	config (config_a),
@@ -28,12 +29,18 @@ nano::vote_generator::vote_generator (nano::node_config const & config_a, nano::
 	stats (stats_a),
 	logger (logger_a),
 	is_final (is_final_a),
-	vote_generation_queue{ stats, nano::stat::type::vote_generator, nano::thread_role::name::vote_generator_queue, /* single threaded */ 1, /* max queue size */ 1024 * 32, /* max batch size */ 256 },
+	vote_generation_queue{ stats, nano::stat::type::vote_generator, nano::thread_role::name::vote_generator_queue, /* single threaded */ 1, /* max queue size */ 1024 * 32, /* max batch size, final votes are recorded in one write per batch */ is_final_a ? 1024u : 256u },
+	bundling{ config_a.vote_generator_delay * 2, config_a.vote_generator_threshold, nano::network::confirm_ack_hashes_max },
 	inproc_channel{ std::make_shared<nano::transport::inproc::channel> (node, node) }
 {
 	vote_generation_queue.process_batch = [this] (auto & batch) {
 		process_batch (batch);
 	};
+
+	if (config.vote_generator_threads > 1)
+	{
+		signing_pool = std::make_unique<nano::thread_pool> (config.vote_generator_threads, nano::thread_role::name::vote_signing);
+	}
 }
 
 nano::vote_generator::~vote_generator ()
@@ -42,34 +49,18 @@ nano::vote_generator::~vote_generator ()
 	debug_assert (!thread.joinable ());
 }
 
-bool nano::vote_generator::should_vote (transaction_variant_t const & transaction_variant, nano::root const & root_a, nano::block_hash const & hash_a) const
+std::shared_ptr<nano::block> nano::vote_generator::should_vote (nano::secure::transaction const & transaction, nano::root const & root_a, nano::block_hash const & hash_a) const
 {
-	bool should_vote = false;
-	std::shared_ptr<nano::block> block;
-	if (is_final)
-	{
-		debug_assert (std::holds_alternative<nano::secure::write_transaction> (transaction_variant));
-		auto const & transaction = std::get<nano::secure::write_transaction> (transaction_variant);
-
-		block = ledger.any.block_get (transaction, hash_a);
-		should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block) && ledger.store.final_vote.put (transaction, block->qualified_root (), hash_a);
-		debug_assert (block == nullptr || root_a == block->root ());
-	}
-	else
-	{
-		debug_assert (std::holds_alternative<nano::secure::read_transaction> (transaction_variant));
-		auto const & transaction = std::get<nano::secure::read_transaction> (transaction_variant);
-
-		block = ledger.any.block_get (transaction, hash_a);
-		should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block);
-	}
+	auto block = ledger.any.block_get (transaction, hash_a);
+	bool const should_vote = block != nullptr && ledger.dependents_confirmed (transaction, *block);
+	debug_assert (block == nullptr || root_a == block->root ());
 
 	logger.trace (nano::log::type::vote_generator, nano::log::detail::should_vote,
 	nano::log::arg{ "should_vote", should_vote },
 	nano::log::arg{ "block", block },
 	nano::log::arg{ "is_final", is_final });
 
-	return should_vote;
+	return should_vote ? block : nullptr;
 }
 
 void nano::vote_generator::start ()
@@ -89,51 +80,56 @@ void nano::vote_generator::stop ()
 
 	lock.unlock ();
 	condition.notify_all ();
+	{
+		// The generator thread may be waiting for signing to catch up
+		nano::lock_guard<nano::mutex> guard{ signing_mutex };
+	}
+	signing_condition.notify_all ();
 
 	if (thread.joinable ())
 	{
 		thread.join ();
 	}
+
+	if (signing_pool)
+	{
+		signing_pool->stop ();
+	}
 }
 
 void nano::vote_generator::add (const root & root, const block_hash & hash)
 {
-	vote_generation_queue.add (std::make_pair (root, hash));
+	vote_generation_queue.add (std::make_tuple (root, hash, std::chrono::steady_clock::now ()));
 }
 
 void nano::vote_generator::process_batch (std::deque<queue_entry_t> & batch)
 {
 	std::deque<candidate_t> verified;
-
-	auto refresh_if_needed = [] (auto && transaction_variant) {
-		std::visit ([&] (auto && transaction) { transaction.refresh_if_needed (); }, transaction_variant);
-	};
-
-	auto verify_batch = [this, &verified, &refresh_if_needed] (auto && transaction_variant, auto && batch) {
-		for (auto & [root, hash] : batch)
+	std::deque<std::pair<std::shared_ptr<nano::block>, std::chrono::steady_clock::time_point>> final_l;
+	{
+		// Final votes only need the write transaction to record them, checking dependents does not hold up other writers
+		auto transaction = ledger.tx_begin_read ();
+		for (auto const & [root, hash, time] : batch)
 		{
-			refresh_if_needed (transaction_variant);
+			transaction.refresh_if_needed ();
 
-			if (should_vote (transaction_variant, root, hash))
+			if (auto block = should_vote (transaction, root, hash))
 			{
-				verified.emplace_back (root, hash);
+				if (is_final)
+				{
+					final_l.emplace_back (block, time);
+				}
+				else
+				{
+					verified.emplace_back (root, hash);
+				}
 			}
 		}
-	};
-
-	if (is_final)
-	{
-		transaction_variant_t transaction_variant{ ledger.tx_begin_write ({ tables::final_votes }, nano::store::writer::voting_final) };
-
-		verify_batch (transaction_variant, batch);
-
-		// Commit write transaction
 	}
-	else
-	{
-		transaction_variant_t transaction_variant{ ledger.tx_begin_read () };
 
-		verify_batch (transaction_variant, batch);
+	if (!final_l.empty ())
+	{
+		verified = record_final (final_l);
 	}
 
 	// Submit verified candidates to the main processing thread
@@ -141,7 +137,9 @@ void nano::vote_generator::process_batch (std::deque<queue_entry_t> & batch)
 	{
 		nano::unique_lock<nano::mutex> lock{ mutex };
 		candidates.insert (candidates.end (), verified.begin (), verified.end ());
-		if (candidates.size () >= nano::network::confirm_ack_hashes_max)
+		bundling.arrived (verified.size ());
+		// The adaptive window is sized on every arrival, a fixed delay only needs waking up for full votes
+		if (config.vote_generator_adaptive || candidates.size () >= nano::network::confirm_ack_hashes_max)
 		{
 			lock.unlock ();
 			condition.notify_all ();
@@ -149,6 +147,31 @@ void nano::vote_generator::process_batch (std::deque<queue_entry_t> & batch)
 	}
 }
 
+auto nano::vote_generator::record_final (std::deque<std::pair<std::shared_ptr<nano::block>, std::chrono::steady_clock::time_point>> const & blocks_a) -> std::deque<candidate_t>
+{
+	debug_assert (is_final);
+	std::deque<candidate_t> result;
+	{
+		auto transaction = ledger.tx_begin_write ({ tables::final_votes }, nano::store::writer::voting_final);
+		for (auto const & [block, time] : blocks_a)
+		{
+			// The block may have been rolled back since it was checked
+			if (ledger.any.block_exists (transaction, block->hash ()) && ledger.store.final_vote.put (transaction, block->qualified_root (), block->hash ()))
+			{
+				result.emplace_back (block->root (), block->hash ());
+			}
+		}
+		transaction.commit ();
+	}
+	// Candidates are only handed out for voting once their final vote records are committed
+	auto const now = std::chrono::steady_clock::now ();
+	auto const oldest = std::min_element (blocks_a.begin (), blocks_a.end (), [] (auto const & lhs, auto const & rhs) { return lhs.second < rhs.second; });
+	stats.inc (nano::stat::type::vote_generator, nano::stat::detail::final_vote_commit);
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::final_vote_commit_records, result.size ());
+	stats.sample (nano::stat::sample::final_vote_commit_latency, std::chrono::duration_cast<std::chrono::milliseconds> (now - oldest->second).count (), { 0, 1000 });
+	return result;
+}
+
 std::size_t nano::vote_generator::generate (std::vector<std::shared_ptr<nano::block>> const & blocks_a, std::shared_ptr<nano::transport::channel> const & channel_a)
 {
 	request_t::first_type req_candidates;
@@ -174,7 +197,7 @@ std::size_t nano::vote_generator::generate (std::vector<std::shared_ptr<nano::bl
 	return result;
 }
 
-void nano::vote_generator::set_reply_action (std::function<void (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &)> action_a)
+void nano::vote_generator::set_reply_action (std::function<void (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const &, std::shared_ptr<nano::transport::channel> const &)> action_a)
 {
 	release_assert (!reply_action);
 	reply_action = action_a;
@@ -207,9 +230,10 @@ void nano::vote_generator::broadcast (nano::unique_lock<nano::mutex> & lock_a)
 	}
 	if (!hashes.empty ())
 	{
+		stats.sample (nano::stat::sample::vote_generator_bundle_size, hashes.size (), { 0, nano::network::confirm_ack_hashes_max });
 		lock_a.unlock ();
-		vote (hashes, roots, [this] (auto const & vote_a) {
-			this->broadcast_action (vote_a);
+		vote (hashes, roots, [this] (auto const & vote_a, auto const & buffer_a) {
+			this->broadcast_action (vote_a, buffer_a);
 			this->stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_broadcasts);
 		});
 		lock_a.lock ();
@@ -219,8 +243,19 @@ void nano::vote_generator::broadcast (nano::unique_lock<nano::mutex> & lock_a)
 void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, request_t && request_a)
 {
 	lock_a.unlock ();
-	auto i (request_a.first.cbegin ());
-	auto n (request_a.first.cend ());
+	if (signing_pool)
+	{
+		// Votes for requested hashes may still be signed on the pool, wait for them so they are reused instead of signed again
+		nano::unique_lock<nano::mutex> lock{ signing_mutex };
+		signing_condition.wait (lock, [this, &request_a] () {
+			return stopped || std::none_of (request_a.first.begin (), request_a.first.end (), [this] (auto const & candidate) {
+				return signing_hashes.contains (candidate.second);
+			});
+		});
+	}
+	auto const to_sign = reuse (request_a);
+	auto i (to_sign.cbegin ());
+	auto n (to_sign.cend ());
 	while (i != n && !stopped)
 	{
 		std::vector<nano::block_hash> hashes;
@@ -246,8 +281,8 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 		if (!hashes.empty ())
 		{
 			stats.add (nano::stat::type::requests, nano::stat::detail::requests_generated_hashes, stat::dir::in, hashes.size ());
-			vote (hashes, roots, [this, &channel = request_a.second] (std::shared_ptr<nano::vote> const & vote_a) {
-				this->reply_action (vote_a, channel);
+			vote (hashes, roots, [this, channel = request_a.second] (std::shared_ptr<nano::vote> const & vote_a, nano::shared_const_buffer const & buffer_a) mutable {
+				this->reply_action (vote_a, buffer_a, channel);
 				this->stats.inc (nano::stat::type::requests, nano::stat::detail::requests_generated_votes, stat::dir::in);
 			});
 		}
@@ -256,30 +291,114 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 	lock_a.lock ();
 }
 
-void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (std::shared_ptr<nano::vote> const &)> const & action_a)
+auto nano::vote_generator::reuse (request_t const & request_a) -> std::vector<candidate_t>
+{
+	// Many peers request votes for the same fresh block within a short time, reply to all of them with the votes signed for the first request
+	auto const voting = wallets.reps ().voting;
+	auto const now = nano::milliseconds_since_epoch ();
+	auto const max_age = static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::milliseconds> (config.network_params.voting.delay).count ());
+
+	std::vector<candidate_t> result;
+	std::unordered_map<std::shared_ptr<nano::vote>, std::optional<nano::shared_const_buffer>> cached;
+	for (auto const & [root, hash] : request_a.first)
+	{
+		auto votes = history.cached (root, hash, is_final);
+		// Final votes never change, normal votes are only reused while the spacing would prevent voting differently anyway
+		std::erase_if (votes, [&] (auto const & entry) {
+			return !entry.vote->is_final () && entry.vote->timestamp () + max_age < now;
+		});
+		if (!votes.empty () && votes.size () >= voting)
+		{
+			for (auto const & entry : votes)
+			{
+				cached.emplace (entry.vote, entry.confirm_ack);
+			}
+			stats.inc (nano::stat::type::requests, nano::stat::detail::requests_cached_hashes, stat::dir::in);
+		}
+		else
+		{
+			result.emplace_back (root, hash);
+		}
+	}
+	auto channel = request_a.second;
+	for (auto const & [vote, confirm_ack] : cached)
+	{
+		reply_action (vote, confirm_ack ? *confirm_ack : nano::confirm_ack{ config.network_params.network, vote }.to_shared_const_buffer (), channel);
+		stats.inc (nano::stat::type::requests, nano::stat::detail::requests_cached_votes, stat::dir::in);
+		stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_signatures_saved);
+	}
+	return result;
+}
+
+void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const &)> const & action_a)
 {
 	debug_assert (hashes_a.size () == roots_a.size ());
-	std::vector<std::shared_ptr<nano::vote>> votes_l;
-	wallets.foreach_representative ([this, &hashes_a, &votes_l] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
-		auto timestamp = this->is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
-		uint8_t duration = this->is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
-		votes_l.emplace_back (std::make_shared<nano::vote> (pub_a, prv_a, timestamp, duration, hashes_a));
-	});
-	for (auto const & vote_l : votes_l)
+
+	// Spacing is only accessed from the generator thread, flag it before signing so votes signed concurrently can never conflict
+	for (std::size_t i (0), n (hashes_a.size ()); i != n; ++i)
 	{
-		for (std::size_t i (0), n (hashes_a.size ()); i != n; ++i)
+		spacing.flag (roots_a[i], hashes_a[i]);
+	}
+
+	auto sign = [this, hashes_a, roots_a, action_a] () {
+		std::vector<std::shared_ptr<nano::vote>> votes_l;
+		wallets.foreach_representative ([this, &hashes_a, &votes_l] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
+			auto timestamp = this->is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
+			uint8_t duration = this->is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
+			votes_l.emplace_back (std::make_shared<nano::vote> (pub_a, prv_a, timestamp, duration, hashes_a));
+		});
+		for (auto const & vote_l : votes_l)
 		{
-			history.add (roots_a[i], hashes_a[i], vote_l);
-			spacing.flag (roots_a[i], hashes_a[i]);
+			// Serialized once, the buffer is shared by the history and every reply or broadcast of this vote
+			auto const buffer = nano::confirm_ack{ config.network_params.network, vote_l }.to_shared_const_buffer ();
+			for (std::size_t i (0), n (hashes_a.size ()); i != n; ++i)
+			{
+				history.add (roots_a[i], hashes_a[i], vote_l, buffer);
+			}
+			action_a (vote_l, buffer);
+		}
+	};
+
+	if (signing_pool)
+	{
+		{
+			// Generating faster than the pool can sign only grows its queue, hold the generator thread back instead
+			nano::unique_lock<nano::mutex> lock{ signing_mutex };
+			auto const max_in_flight = signing_pool->get_num_threads () * max_signing_per_thread;
+			if (signing_in_flight >= max_in_flight)
+			{
+				stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_signing_wait);
+				signing_condition.wait (lock, [this, max_in_flight] () {
+					return stopped || signing_in_flight < max_in_flight;
+				});
+			}
+			++signing_in_flight;
+			signing_hashes.insert (hashes_a.begin (), hashes_a.end ());
 		}
-		action_a (vote_l);
+		stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_signing_queued);
+		signing_pool->push_task ([this, sign = std::move (sign), hashes_a] () {
+			sign ();
+			{
+				nano::lock_guard<nano::mutex> guard{ signing_mutex };
+				--signing_in_flight;
+				for (auto const & hash : hashes_a)
+				{
+					signing_hashes.erase (signing_hashes.find (hash));
+				}
+			}
+			signing_condition.notify_all ();
+		});
+	}
+	else
+	{
+		sign ();
 	}
 }
 
-void nano::vote_generator::broadcast_action (std::shared_ptr<nano::vote> const & vote_a) const
+void nano::vote_generator::broadcast_action (std::shared_ptr<nano::vote> const & vote_a, nano::shared_const_buffer const & buffer_a) const
 {
-	network.flood_vote_pr (vote_a);
-	network.flood_vote (vote_a, 2.0f);
+	network.flood_vote_pr (vote_a, buffer_a);
+	network.flood_vote (vote_a, buffer_a, 2.0f);
 	vote_processor.vote (vote_a, inproc_channel);
 }
 
@@ -299,6 +418,10 @@ void nano::vote_generator::run ()
 			requests.pop_front ();
 			reply (lock, std::move (request));
 		}
+		else if (config.vote_generator_adaptive)
+		{
+			wait_adaptive (lock);
+		}
 		else
 		{
 			condition.wait_for (lock, config.vote_generator_delay, [this] () { return this->candidates.size () >= nano::network::confirm_ack_hashes_max; });
@@ -314,6 +437,33 @@ void nano::vote_generator::run ()
 	}
 }
 
+void nano::vote_generator::wait_adaptive (nano::unique_lock<nano::mutex> & lock_a)
+{
+	debug_assert (lock_a.owns_lock ());
+	if (candidates.empty ())
+	{
+		condition.wait_for (lock_a, config.vote_generator_delay, [this] () { return stopped || !this->candidates.empty (); });
+		return;
+	}
+	auto const window = bundling.window (candidates.size ());
+	if (window > std::chrono::milliseconds{ 0 })
+	{
+		stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_bundle_waited);
+		auto const start = std::chrono::steady_clock::now ();
+		condition.wait_for (lock_a, window, [this] () { return stopped || this->candidates.size () >= nano::network::confirm_ack_hashes_max; });
+		auto const waited = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+		stats.sample (nano::stat::sample::vote_generator_bundle_wait, waited.count (), { 0, config.vote_generator_delay.count () * 2 });
+	}
+	else
+	{
+		stats.inc (nano::stat::type::vote_generator, nano::stat::detail::generator_bundle_immediate);
+	}
+	if (!stopped && !candidates.empty ())
+	{
+		broadcast (lock_a);
+	}
+}
+
 std::unique_ptr<nano::container_info_component> nano::vote_generator::collect_container_info (std::string const & name) const
 {
 	std::size_t candidates_count = 0;
@@ -329,5 +479,9 @@ std::unique_ptr<nano::container_info_component> nano::vote_generator::collect_co
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "candidates", candidates_count, sizeof_candidate_element }));
 	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "requests", requests_count, sizeof_request_element }));
 	composite->add_component (vote_generation_queue.collect_container_info ("vote_generation_queue"));
+	if (signing_pool)
+	{
+		composite->add_component (signing_pool->collect_container_info ("signing_pool"));
+	}
 	return composite;
 }
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <nano/lib/asio.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/logging.hpp>
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/processing_queue.hpp>
+#include <nano/lib/thread_pool.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/node/vote_bundling.hpp>
 #include <nano/node/wallet.hpp>
 #include <nano/secure/common.hpp>
 
@@ -17,7 +20,8 @@
 #include <condition_variable>
 #include <deque>
 #include <thread>
-#include <variant>
+#include <tuple>
+#include <unordered_set>
 
 namespace mi = boost::multi_index;
 
@@ -51,7 +55,8 @@ class vote_generator final
 private:
 	using candidate_t = std::pair<nano::root, nano::block_hash>;
 	using request_t = std::pair<std::vector<candidate_t>, std::shared_ptr<nano::transport::channel>>;
-	using queue_entry_t = std::pair<nano::root, nano::block_hash>;
+	/** Root, hash and the time the entry was queued */
+	using queue_entry_t = std::tuple<nano::root, nano::block_hash, std::chrono::steady_clock::time_point>;
 
 public:
 	vote_generator (nano::node_config const &, nano::node &, nano::ledger &, nano::wallets &, nano::vote_processor &, nano::local_vote_history &, nano::network &, nano::stats &, nano::logger &, bool is_final);
@@ -61,7 +66,8 @@ public:
 	void add (nano::root const &, nano::block_hash const &);
 	/** Queue blocks for vote generation, returning the number of successful candidates.*/
 	std::size_t generate (std::vector<std::shared_ptr<nano::block>> const & blocks_a, std::shared_ptr<nano::transport::channel> const & channel_a);
-	void set_reply_action (std::function<void (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &)>);
+	/** The reply action receives each vote together with its serialized confirm_ack */
+	void set_reply_action (std::function<void (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const &, std::shared_ptr<nano::transport::channel> const &)>);
 
 	void start ();
 	void stop ();
@@ -69,18 +75,23 @@ public:
 	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
 
 private:
-	using transaction_variant_t = std::variant<nano::secure::read_transaction, nano::secure::write_transaction>;
-
 	void run ();
+	/** Waits for a bundle of candidates, sized by the adaptive bundling window */
+	void wait_adaptive (nano::unique_lock<nano::mutex> &);
 	void broadcast (nano::unique_lock<nano::mutex> &);
 	void reply (nano::unique_lock<nano::mutex> &, request_t &&);
-	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (std::shared_ptr<nano::vote> const &)> const &);
-	void broadcast_action (std::shared_ptr<nano::vote> const &) const;
+	/** Replies with recently signed votes covering the request, returns the candidates that still need signing */
+	std::vector<candidate_t> reuse (request_t const &);
+	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const &)> const &);
+	void broadcast_action (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const &) const;
 	void process_batch (std::deque<queue_entry_t> & batch);
-	bool should_vote (transaction_variant_t const &, nano::root const &, nano::block_hash const &) const;
+	/** Returns the block if it exists and its dependents are confirmed, otherwise nullptr */
+	std::shared_ptr<nano::block> should_vote (nano::secure::transaction const &, nano::root const &, nano::block_hash const &) const;
+	/** Records final votes for a whole batch in one write transaction, returns the candidates with durable records */
+	std::deque<candidate_t> record_final (std::deque<std::pair<std::shared_ptr<nano::block>, std::chrono::steady_clock::time_point>> const &);
 
 private:
-	std::function<void (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> &)> reply_action; // must be set only during initialization by using set_reply_action
+	std::function<void (std::shared_ptr<nano::vote> const &, nano::shared_const_buffer const &, std::shared_ptr<nano::transport::channel> &)> reply_action; // must be set only during initialization by using set_reply_action
 
 private: // Dependencies
 	nano::node_config const & config;
@@ -97,6 +108,15 @@ private: // Dependencies
 
 private:
 	processing_queue<queue_entry_t> vote_generation_queue;
+	/** Signs votes bundled by the generator thread, only used with more than one configured signing thread */
+	std::unique_ptr<nano::thread_pool> signing_pool;
+	/** Bundles allowed in flight per signing thread before the generator thread waits */
+	static std::size_t constexpr max_signing_per_thread{ 4 };
+	nano::mutex signing_mutex;
+	nano::condition_variable signing_condition;
+	std::size_t signing_in_flight{ 0 };
+	/** Hashes of bundles still being signed, replies for them wait so the signed votes can be reused */
+	std::unordered_multiset<nano::block_hash> signing_hashes;
 
 private:
 	const bool is_final;
@@ -105,6 +125,7 @@ private:
 	static std::size_t constexpr max_requests{ 2048 };
 	std::deque<request_t> requests;
 	std::deque<candidate_t> candidates;
+	nano::vote_bundling_window bundling;
 	std::atomic<bool> stopped{ false };
 	std::thread thread;
 	std::shared_ptr<nano::transport::channel> inproc_channel;
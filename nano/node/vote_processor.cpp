@@ -19,7 +19,7 @@ using namespace std::chrono_literals;
  * vote_processor
  */
 
-nano::vote_processor::vote_processor (vote_processor_config const & config_a, nano::vote_router & vote_router, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_flags & flags_a, nano::logger & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a, nano::rep_tiers & rep_tiers_a) :
+nano::vote_processor::vote_processor (vote_processor_config const & config_a, nano::vote_router & vote_router, nano::node_observers & observers_a, nano::stats & stats_a, nano::node_flags & flags_a, nano::logger & logger_a, nano::online_reps & online_reps_a, nano::rep_crawler & rep_crawler_a, nano::ledger & ledger_a, nano::network_params & network_params_a, nano::rep_tiers & rep_tiers_a, nano::vote_timestamps & timestamps_a) :
 	config{ config_a },
 	vote_router{ vote_router },
 	observers{ observers_a },
@@ -29,7 +29,8 @@ nano::vote_processor::vote_processor (vote_processor_config const & config_a, na
 	rep_crawler{ rep_crawler_a },
 	ledger{ ledger_a },
 	network_params{ network_params_a },
-	rep_tiers{ rep_tiers_a }
+	rep_tiers{ rep_tiers_a },
+	timestamps{ timestamps_a }
 {
 	queue.max_size_query = [this] (auto const & origin) {
 		switch (origin.source)
@@ -104,7 +105,14 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote, std::
 {
 	debug_assert (channel != nullptr);
 
-	auto const tier = rep_tiers.tier (vote->account);
+	auto const [tier, rep_id] = rep_tiers.tier_id (vote->account);
+
+	// Rebroadcasts of votes already applied to elections carry no new information, drop them before signature validation
+	if (tier != nano::rep_tier::none && rep_id && timestamps.replay (*rep_id, *vote))
+	{
+		stats.inc (nano::stat::type::vote_processor, nano::stat::detail::replay_filtered);
+		return true;
+	}
 
 	bool added = false;
 	{
@@ -193,6 +201,21 @@ nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote>
 		}
 		result = replay ? nano::vote_code::replay : (processed ? nano::vote_code::vote : nano::vote_code::indeterminate);
 
+		// Only hashes that reached an election are recorded, votes for other hashes are kept by the vote cache
+		if (replay || processed)
+		{
+			if (auto rep_id = rep_tiers.rep_id (vote->account))
+			{
+				for (auto const & [hash, hash_result] : vote_results)
+				{
+					if (hash_result == nano::vote_code::vote || hash_result == nano::vote_code::replay)
+					{
+						timestamps.update (*rep_id, hash, vote->timestamp ());
+					}
+				}
+			}
+		}
+
 		observers.vote.notify (vote, channel, source, result);
 	}
 
@@ -362,6 +385,7 @@ nano::error nano::vote_processor_config::serialize (nano::tomlconfig & toml) con
 	toml.put ("pr_priority", pr_priority, "Priority for votes from principal representatives. Higher priority gets processed more frequently. Non-principal representatives have a baseline priority of 1. \ntype:uint64");
 	toml.put ("threads", threads, "Number of threads to use for processing votes. \ntype:uint64");
 	toml.put ("batch_size", batch_size, "Maximum number of votes to process in a single batch. \ntype:uint64");
+	toml.put ("max_timestamps", max_timestamps, "Number of slots remembering the latest vote timestamp of a representative for a block hash, 64 slots are reserved for each principal representative. Used to drop replayed votes before validation. \ntype:uint64");
 
 	return toml.get_error ();
 }
@@ -373,6 +397,7 @@ nano::error nano::vote_processor_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("pr_priority", pr_priority);
 	toml.get ("threads", threads);
 	toml.get ("batch_size", batch_size);
+	toml.get ("max_timestamps", max_timestamps);
 
 	return toml.get_error ();
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <nano/node/fwd.hpp>
 #include <nano/node/rep_tiers.hpp>
 #include <nano/node/vote_router.hpp>
+#include <nano/node/vote_timestamps.hpp>
 #include <nano/secure/common.hpp>
 
 #include <deque>
@@ -31,18 +32,19 @@ public:
 	size_t threads{ std::clamp (nano::hardware_concurrency () / 2, 1u, 4u) };
 	size_t batch_size{ 1024 };
 	size_t max_triggered{ 16384 };
+	size_t max_timestamps{ 1024 * 64 };
 };
 
 class vote_processor final
 {
 public:
-	vote_processor (vote_processor_config const &, nano::vote_router &, nano::node_observers &, nano::stats &, nano::node_flags &, nano::logger &, nano::online_reps &, nano::rep_crawler &, nano::ledger &, nano::network_params &, nano::rep_tiers &);
+	vote_processor (vote_processor_config const &, nano::vote_router &, nano::node_observers &, nano::stats &, nano::node_flags &, nano::logger &, nano::online_reps &, nano::rep_crawler &, nano::ledger &, nano::network_params &, nano::rep_tiers &, nano::vote_timestamps &);
 	~vote_processor ();
 
 	void start ();
 	void stop ();
 
-	/** Queue vote for processing. @returns true if the vote was queued */
+	/** Queue vote for processing. @returns true if the vote was queued or dropped as a replay */
 	bool vote (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source = nano::vote_source::live);
 	nano::vote_code vote_blocking (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source = nano::vote_source::live);
 
@@ -67,6 +69,7 @@ private: // Dependencies
 	nano::ledger & ledger;
 	nano::network_params & network_params;
 	nano::rep_tiers & rep_tiers;
+	nano::vote_timestamps & timestamps;
 
 private:
 	void run ();
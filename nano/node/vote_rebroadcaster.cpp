@@ -0,0 +1,233 @@
+#include <nano/lib/stats.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/tomlconfig.hpp>
+#include <nano/node/network.hpp>
+#include <nano/node/recently_confirmed_cache.hpp>
+#include <nano/node/vote_rebroadcaster.hpp>
+#include <nano/node/vote_router.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/vote.hpp>
+
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+nano::vote_rebroadcaster::vote_rebroadcaster (vote_rebroadcaster_config const & config_a, nano::ledger & ledger_a, nano::network & network_a, nano::recently_confirmed_cache & recently_confirmed_a, nano::stats & stats_a) :
+	config{ config_a },
+	ledger{ ledger_a },
+	network{ network_a },
+	recently_confirmed{ recently_confirmed_a },
+	stats{ stats_a },
+	limiter{ config.max_rate, config.rate_burst_ratio }
+{
+}
+
+nano::vote_rebroadcaster::~vote_rebroadcaster ()
+{
+	// Thread must be stopped before destruction
+	debug_assert (!thread.joinable ());
+}
+
+void nano::vote_rebroadcaster::start ()
+{
+	debug_assert (!thread.joinable ());
+
+	thread = std::thread{ [this] () {
+		nano::thread_role::set (nano::thread_role::name::vote_rebroadcasting);
+		run ();
+	} };
+}
+
+void nano::vote_rebroadcaster::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+bool nano::vote_rebroadcaster::push (std::shared_ptr<nano::vote> const & vote, std::unordered_map<nano::block_hash, nano::vote_code> const & results)
+{
+	std::vector<nano::block_hash> counted;
+	for (auto const & [hash, result] : results)
+	{
+		if (result == nano::vote_code::vote)
+		{
+			counted.push_back (hash);
+		}
+	}
+	if (counted.empty ())
+	{
+		return false;
+	}
+
+	// A vote moves some election towards quorum unless all the blocks it was counted for are already confirmed
+	bool const confirmed = already_confirmed (counted);
+
+	entry entry{ vote, counted, ledger.weight (vote->account), vote->is_final (), confirmed, std::chrono::steady_clock::now () };
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+
+		if (confirmed)
+		{
+			// Only the first vote seen after confirmation is rebroadcast, it is usually the one that reached quorum and helps peers confirm too
+			auto & by_hash = propagated.get<tag_hash> ();
+			bool const fresh = std::any_of (counted.begin (), counted.end (), [&by_hash] (auto const & hash) {
+				return by_hash.find (hash) == by_hash.end ();
+			});
+			if (!fresh)
+			{
+				stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::already_confirmed);
+				return false;
+			}
+			for (auto const & hash : counted)
+			{
+				propagated.push_back (hash);
+			}
+			while (propagated.size () > max_propagated)
+			{
+				propagated.pop_front ();
+			}
+		}
+
+		if (queue.size () >= config.max_queue)
+		{
+			// Make room by dropping the lowest priority vote, unless the new one is not any better
+			auto & by_priority = queue.get<tag_priority> ();
+			auto lowest = std::prev (by_priority.end ());
+			if (lowest->priority () >= entry.priority ())
+			{
+				stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::overfill);
+				return false;
+			}
+			by_priority.erase (lowest);
+			stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::evicted);
+		}
+		queue.insert (entry);
+	}
+	stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::queued);
+	condition.notify_all ();
+	return true;
+}
+
+bool nano::vote_rebroadcaster::already_propagated (std::vector<nano::block_hash> const & hashes) const
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto const & by_hash = propagated.get<tag_hash> ();
+	return std::all_of (hashes.begin (), hashes.end (), [&by_hash] (auto const & hash) {
+		return by_hash.find (hash) != by_hash.end ();
+	});
+}
+
+bool nano::vote_rebroadcaster::already_confirmed (std::vector<nano::block_hash> const & hashes) const
+{
+	return std::all_of (hashes.begin (), hashes.end (), [this] (auto const & hash) {
+		return recently_confirmed.exists (hash);
+	});
+}
+
+void nano::vote_rebroadcaster::run ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		condition.wait (lock, [this] { return stopped || !queue.empty (); });
+		if (stopped)
+		{
+			return;
+		}
+
+		stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::loop);
+
+		// Each rebroadcast costs one message per selected peer
+		auto const cost = std::clamp<std::size_t> (network.fanout (fanout_scale), 1, std::max<std::size_t> (limiter.capacity (), 1));
+		if (!limiter.should_pass (cost))
+		{
+			// Out of budget, wait for it to refill, higher priority votes arriving in the meantime go first
+			stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::cooldown);
+			condition.wait_for (lock, 10ms);
+			continue;
+		}
+
+		auto & by_priority = queue.get<tag_priority> ();
+		auto entry = *by_priority.begin ();
+		by_priority.erase (by_priority.begin ());
+
+		if (std::chrono::steady_clock::now () - entry.enqueued > config.max_age)
+		{
+			stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::stale);
+			continue;
+		}
+
+		// Blocks may have been confirmed and propagated by another vote while this one was waiting
+		if (!entry.confirmation && already_propagated (entry.counted))
+		{
+			stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::already_confirmed);
+			continue;
+		}
+
+		lock.unlock ();
+
+		// Confirmed since it was queued, peers get the vote that confirmed the blocks instead
+		if (!entry.confirmation && already_confirmed (entry.counted))
+		{
+			stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::already_confirmed);
+			lock.lock ();
+			continue;
+		}
+
+		stats.inc (nano::stat::type::vote_rebroadcaster, nano::stat::detail::rebroadcast, nano::stat::dir::out);
+		network.flood_vote (entry.vote, fanout_scale, /* rebroadcasted */ true);
+
+		lock.lock ();
+	}
+}
+
+std::size_t nano::vote_rebroadcaster::size () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return queue.size ();
+}
+
+std::unique_ptr<nano::container_info_component> nano::vote_rebroadcaster::collect_container_info (std::string const & name) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "queue", queue.size (), sizeof (ordered_queue::value_type) }));
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "propagated", propagated.size (), sizeof (ordered_confirmed::value_type) }));
+	return composite;
+}
+
+/*
+ * vote_rebroadcaster_config
+ */
+
+nano::error nano::vote_rebroadcaster_config::serialize (nano::tomlconfig & toml) const
+{
+	toml.put ("max_queue", max_queue, "Maximum number of votes waiting to be rebroadcast. Lowest priority votes are dropped first. \ntype:uint64");
+	toml.put ("max_rate", max_rate, "Maximum number of rebroadcast vote messages sent per second, 0 for unlimited. \ntype:uint64");
+	toml.put ("rate_burst_ratio", rate_burst_ratio, "Burst ratio for the rebroadcast rate limit. \ntype:double");
+	toml.put ("max_age", max_age.count (), "Votes waiting longer than this to be rebroadcast are dropped. \ntype:milliseconds");
+
+	return toml.get_error ();
+}
+
+nano::error nano::vote_rebroadcaster_config::deserialize (nano::tomlconfig & toml)
+{
+	toml.get ("max_queue", max_queue);
+	toml.get ("max_rate", max_rate);
+	toml.get ("rate_burst_ratio", rate_burst_ratio);
+
+	auto max_age_l = max_age.count ();
+	toml.get ("max_age", max_age_l);
+	max_age = std::chrono::milliseconds{ max_age_l };
+
+	return toml.get_error ();
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/rate_limiting.hpp>
+#include <nano/lib/utility.hpp>
+#include <nano/node/fwd.hpp>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mi = boost::multi_index;
+
+namespace nano
+{
+class recently_confirmed_cache;
+class vote;
+}
+
+namespace nano
+{
+class vote_rebroadcaster_config final
+{
+public:
+	nano::error deserialize (nano::tomlconfig & toml);
+	nano::error serialize (nano::tomlconfig & toml) const;
+
+public:
+	std::size_t max_queue{ 1024 * 4 };
+	/** Outbound budget in confirm_ack messages per second, 0 for unlimited */
+	std::size_t max_rate{ 2500 };
+	double rate_burst_ratio{ 3.0 };
+	/** Votes waiting longer than this are dropped, elections have likely moved on */
+	std::chrono::milliseconds max_age{ 5000 };
+};
+
+/**
+ * Rebroadcasts votes received from other representatives to a subset of peers within an outbound message budget
+ * Final votes and votes from higher weight representatives are sent first when the budget is tight
+ * Once a root is confirmed only the vote that carried the confirmation is rebroadcast, later votes for it are dropped
+ */
+class vote_rebroadcaster final
+{
+public:
+	vote_rebroadcaster (vote_rebroadcaster_config const &, nano::ledger &, nano::network &, nano::recently_confirmed_cache &, nano::stats &);
+	~vote_rebroadcaster ();
+
+	void start ();
+	void stop ();
+
+	/**
+	 * Queues a processed vote for rebroadcasting if it was counted by an election
+	 * @return true if the vote was queued
+	 */
+	bool push (std::shared_ptr<nano::vote> const &, std::unordered_map<nano::block_hash, nano::vote_code> const & results);
+
+	std::size_t size () const;
+
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
+	static float constexpr fanout_scale = 0.5f;
+	static std::size_t constexpr max_propagated = 1024 * 16;
+
+private: // Dependencies
+	vote_rebroadcaster_config const & config;
+	nano::ledger & ledger;
+	nano::network & network;
+	nano::recently_confirmed_cache & recently_confirmed;
+	nano::stats & stats;
+
+private:
+	void run ();
+	bool already_propagated (std::vector<nano::block_hash> const &) const;
+	bool already_confirmed (std::vector<nano::block_hash> const &) const;
+
+private:
+	struct entry
+	{
+		std::shared_ptr<nano::vote> vote;
+		/** Hashes the vote was counted for by elections */
+		std::vector<nano::block_hash> counted;
+		nano::uint128_t weight;
+		bool final;
+		/** The vote is the first one seen after its blocks got confirmed */
+		bool confirmation;
+		std::chrono::steady_clock::time_point enqueued;
+
+		std::pair<bool, nano::uint128_t> priority () const
+		{
+			return { final, weight };
+		}
+	};
+
+	// clang-format off
+	class tag_priority {};
+	class tag_sequenced {};
+	class tag_hash {};
+
+	using ordered_queue = boost::multi_index_container<entry,
+	mi::indexed_by<
+		mi::ordered_non_unique<mi::tag<tag_priority>,
+			mi::const_mem_fun<entry, std::pair<bool, nano::uint128_t>, &entry::priority>, std::greater<>> // DESC
+	>>;
+
+	using ordered_confirmed = boost::multi_index_container<nano::block_hash,
+	mi::indexed_by<
+		mi::sequenced<mi::tag<tag_sequenced>>,
+		mi::hashed_unique<mi::tag<tag_hash>,
+			mi::identity<nano::block_hash>, std::hash<nano::block_hash>>
+	>>;
+	// clang-format on
+
+	ordered_queue queue;
+	/** Confirmed hashes a vote has already been rebroadcast for */
+	ordered_confirmed propagated;
+
+	nano::rate_limiter limiter;
+
+	bool stopped{ false };
+	nano::condition_variable condition;
+	mutable nano::mutex mutex;
+	std::thread thread;
+};
+}
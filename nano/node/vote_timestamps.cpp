@@ -0,0 +1,102 @@
+#include <nano/node/vote_timestamps.hpp>
+#include <nano/secure/vote.hpp>
+
+#include <algorithm>
+#include <limits>
+
+nano::vote_timestamps::vote_timestamps (std::size_t max_size_a) :
+	max_reps{ max_size_a / slots_per_rep }
+{
+	static_assert (slots_per_rep <= std::numeric_limits<decltype (cursors)::value_type>::max () + 1);
+}
+
+std::size_t nano::vote_timestamps::find (uint32_t rep_id, nano::block_hash const & hash) const
+{
+	debug_assert (!mutex.try_lock ());
+	if (rep_id >= cursors.size ())
+	{
+		return slots.size ();
+	}
+	auto const begin = slots.begin () + rep_id * slots_per_rep;
+	auto const end = begin + slots_per_rep;
+	auto existing = std::find_if (begin, end, [&hash] (auto const & slot) {
+		return slot.hash == hash;
+	});
+	return existing != end ? existing - slots.begin () : slots.size ();
+}
+
+bool nano::vote_timestamps::replay (uint32_t rep_id, nano::vote const & vote) const
+{
+	auto const timestamp = vote.timestamp ();
+
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	if (used == 0)
+	{
+		return false;
+	}
+	return std::all_of (vote.hashes.begin (), vote.hashes.end (), [&] (auto const & hash) {
+		auto existing = find (rep_id, hash);
+		return existing != slots.size () && slots[existing].timestamp >= timestamp;
+	});
+}
+
+void nano::vote_timestamps::update (uint32_t rep_id, nano::block_hash const & hash, uint64_t timestamp)
+{
+	debug_assert (!hash.is_zero ());
+	if (rep_id >= max_reps)
+	{
+		return; // Representatives beyond the capacity are not filtered
+	}
+
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	if (auto existing = find (rep_id, hash); existing != slots.size ())
+	{
+		slots[existing].timestamp = std::max (slots[existing].timestamp, timestamp);
+		return;
+	}
+	if (rep_id >= cursors.size ())
+	{
+		cursors.resize (rep_id + 1, 0);
+		slots.resize (cursors.size () * slots_per_rep);
+	}
+	auto & cursor = cursors[rep_id];
+	auto & entry = slots[rep_id * slots_per_rep + cursor];
+	cursor = static_cast<uint8_t> ((cursor + 1) % slots_per_rep);
+	if (entry.hash.is_zero ())
+	{
+		++used;
+	}
+	entry = { hash, timestamp };
+}
+
+void nano::vote_timestamps::erase (nano::block_hash const & hash)
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	if (used == 0)
+	{
+		return;
+	}
+	for (auto & entry : slots)
+	{
+		if (entry.hash == hash)
+		{
+			entry = {};
+			--used;
+		}
+	}
+}
+
+std::size_t nano::vote_timestamps::size () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return used;
+}
+
+std::unique_ptr<nano::container_info_component> nano::vote_timestamps::collect_container_info (std::string const & name) const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+
+	auto composite = std::make_unique<container_info_composite> (name);
+	composite->add_component (std::make_unique<container_info_leaf> (container_info{ "slots", slots.size (), sizeof (decltype (slots)::value_type) }));
+	return composite;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nano
+{
+class vote;
+}
+
+namespace nano
+{
+/**
+ * Pre-validation replay filter, drops rebroadcast votes that were already applied to an election before they are queued and validated
+ * Keeps the latest vote timestamps for the most recent block hashes voted on by each principal representative
+ * Slots are stored in one flat array indexed by the dense representative ids assigned by rep_tiers, without per entry allocations
+ * Elections and the vote cache keep their own vote bookkeeping, a miss here only means the vote goes through the regular checks
+ */
+class vote_timestamps final
+{
+public:
+	/** @param max_size Total number of slots, divided into `slots_per_rep` slots for each tracked representative */
+	explicit vote_timestamps (std::size_t max_size);
+
+	/**
+	 * Checks whether every hash in the vote was already seen from the same representative with an equal or newer timestamp
+	 * @return true if the vote carries no new information
+	 */
+	bool replay (uint32_t rep_id, nano::vote const &) const;
+	/** Records the vote timestamp for a hash, keeping the newest one. Overwrites the oldest slot of the representative when full */
+	void update (uint32_t rep_id, nano::block_hash const &, uint64_t timestamp);
+	/** Forgets timestamps for a hash from all representatives */
+	void erase (nano::block_hash const &);
+
+	std::size_t size () const;
+
+	std::unique_ptr<container_info_component> collect_container_info (std::string const & name) const;
+
+public:
+	static std::size_t constexpr slots_per_rep{ 64 };
+
+private:
+	struct slot
+	{
+		nano::block_hash hash{ 0 }; // Zero marks an unused slot
+		uint64_t timestamp{ 0 };
+	};
+
+	/** Index of the slot holding the hash for the representative, or the number of slots if there is none */
+	std::size_t find (uint32_t rep_id, nano::block_hash const &) const;
+
+	std::size_t const max_reps;
+
+	// `slots_per_rep` consecutive slots for each representative id, grown up to the highest id seen
+	std::vector<slot> slots;
+	// Next slot to overwrite for each representative id
+	std::vector<uint8_t> cursors;
+	std::size_t used{ 0 };
+	mutable nano::mutex mutex;
+};
+}
@@ -1287,138 +1287,82 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 
 	if (!rocksdb_store->init_error ())
 	{
-		auto table_size = store.count (store.tx_begin_read (), tables::blocks);
-		logger.info (nano::log::type::ledger, "Step 1 of 7: Converting {} entries from blocks table", table_size);
-		std::atomic<std::size_t> count = 0;
-		store.block.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::blocks }));
-			for (; i != n; ++i)
-			{
-				rocksdb_transaction.refresh_if_needed ();
-				std::vector<uint8_t> vector;
+		std::size_t step = 0;
+		// Source tables are read in parallel ranges, each range is written through its own bulk transaction
+		auto migrate_table = [&] (nano::tables table, std::string_view name, auto const & for_each_par, auto const & put) {
+			auto const table_size = store.count (store.tx_begin_read (), table);
+			logger.info (nano::log::type::ledger, "Step {} of 7: Converting {} entries from {} table", ++step, table_size, name);
+
+			std::atomic<uint64_t> count{ 0 };
+			auto const start = std::chrono::steady_clock::now ();
+			auto log_progress = [&] (uint64_t count_l) {
+				auto const elapsed = std::chrono::duration_cast<std::chrono::seconds> (std::chrono::steady_clock::now () - start).count ();
+				logger.info (nano::log::type::ledger, "{} entries converted ({}%, {} entries/s)", count_l, table_size > 0 ? count_l * 100 / table_size : 100, elapsed > 0 ? count_l / elapsed : count_l);
+			};
+
+			for_each_par ([&] (store::read_transaction const & /*unused*/, auto i, auto n) {
+				auto rocksdb_transaction = rocksdb_store->tx_begin_write_bulk ({ table });
+				for (; i != n; ++i)
 				{
-					nano::vectorstream stream (vector);
-					nano::serialize_block (stream, *i->second.block);
-					i->second.sideband.serialize (stream, i->second.block->type ());
+					rocksdb_transaction.refresh_if_needed ();
+					put (rocksdb_transaction, i->first, i->second);
+					if (auto count_l = ++count; count_l % 1000000 == 0)
+					{
+						log_progress (count_l);
+					}
 				}
-				rocksdb_store->block.raw_put (rocksdb_transaction, vector, i->first);
+			});
+			log_progress (count.load ());
 
-				if (auto count_l = ++count; count_l % 5000000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} blocks converted ({}%)", count_l, count_l * 100 / table_size);
-				}
-			}
-		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
-
-		table_size = store.count (store.tx_begin_read (), tables::pending);
-		logger.info (nano::log::type::ledger, "Step 2 of 7: Converting {} entries from pending table", table_size);
-		count = 0;
-		store.pending.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::pending }));
-			for (; i != n; ++i)
+			if (count.load () != table_size)
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->pending.put (rocksdb_transaction, i->first, i->second);
-				if (auto count_l = ++count; count_l % 500000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
-				}
+				logger.error (nano::log::type::ledger, "Converted {} entries from {} table, expected {}", count.load (), name, table_size);
+				error = true;
 			}
-		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
+		};
 
-		table_size = store.count (store.tx_begin_read (), tables::confirmation_height);
-		logger.info (nano::log::type::ledger, "Step 3 of 7: Converting {} entries from confirmation_height table", table_size);
-		count = 0;
-		store.confirmation_height.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::confirmation_height }));
-			for (; i != n; ++i)
+		migrate_table (
+		tables::blocks, "blocks",
+		[&] (auto const & action) { store.block.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & value) {
+			std::vector<uint8_t> vector;
 			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->confirmation_height.put (rocksdb_transaction, i->first, i->second);
-				if (auto count_l = ++count; count_l % 500000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
-				}
+				nano::vectorstream stream (vector);
+				nano::serialize_block (stream, *value.block);
+				value.sideband.serialize (stream, value.block->type ());
 			}
+			rocksdb_store->block.raw_put (transaction, vector, key);
 		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
 
-		table_size = store.count (store.tx_begin_read (), tables::accounts);
-		logger.info (nano::log::type::ledger, "Step 4 of 7: Converting {} entries from accounts table", table_size);
-		count = 0;
-		store.account.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::accounts }));
-			for (; i != n; ++i)
-			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->account.put (rocksdb_transaction, i->first, i->second);
-				if (auto count_l = ++count; count_l % 500000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
-				}
-			}
-		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
+		migrate_table (
+		tables::pending, "pending",
+		[&] (auto const & action) { store.pending.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & value) { rocksdb_store->pending.put (transaction, key, value); });
 
-		table_size = store.count (store.tx_begin_read (), tables::rep_weights);
-		logger.info (nano::log::type::ledger, "Step 5 of 7: Converting {} entries from rep_weights table", table_size);
-		count = 0;
-		store.rep_weight.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::rep_weights }));
-			for (; i != n; ++i)
-			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->rep_weight.put (rocksdb_transaction, i->first, i->second.number ());
-				if (auto count_l = ++count; count_l % 500000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
-				}
-			}
-		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
-
-		table_size = store.count (store.tx_begin_read (), tables::pruned);
-		logger.info (nano::log::type::ledger, "Step 6 of 7: Converting {} entries from pruned table", table_size);
-		count = 0;
-		store.pruned.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::pruned }));
-			for (; i != n; ++i)
-			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->pruned.put (rocksdb_transaction, i->first);
-				if (auto count_l = ++count; count_l % 500000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
-				}
-			}
-		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
-
-		table_size = store.count (store.tx_begin_read (), tables::final_votes);
-		logger.info (nano::log::type::ledger, "Step 7 of 7: Converting {} entries from final_votes table", table_size);
-		count = 0;
-		store.final_vote.for_each_par (
-		[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
-			auto rocksdb_transaction (rocksdb_store->tx_begin_write ({}, { nano::tables::final_votes }));
-			for (; i != n; ++i)
-			{
-				rocksdb_transaction.refresh_if_needed ();
-				rocksdb_store->final_vote.put (rocksdb_transaction, i->first, i->second);
-				if (auto count_l = ++count; count_l % 500000 == 0)
-				{
-					logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count_l, count_l * 100 / table_size);
-				}
-			}
-		});
-		logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
+		migrate_table (
+		tables::confirmation_height, "confirmation_height",
+		[&] (auto const & action) { store.confirmation_height.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & value) { rocksdb_store->confirmation_height.put (transaction, key, value); });
+
+		migrate_table (
+		tables::accounts, "accounts",
+		[&] (auto const & action) { store.account.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & value) { rocksdb_store->account.put (transaction, key, value); });
+
+		migrate_table (
+		tables::rep_weights, "rep_weights",
+		[&] (auto const & action) { store.rep_weight.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & value) { rocksdb_store->rep_weight.put (transaction, key, value.number ()); });
+
+		migrate_table (
+		tables::pruned, "pruned",
+		[&] (auto const & action) { store.pruned.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & /*unused*/) { rocksdb_store->pruned.put (transaction, key); });
+
+		migrate_table (
+		tables::final_votes, "final_votes",
+		[&] (auto const & action) { store.final_vote.for_each_par (action); },
+		[&] (auto const & transaction, auto const & key, auto const & value) { rocksdb_store->final_vote.put (transaction, key, value); });
 
 		logger.info (nano::log::type::ledger, "Finalizing migration...");
 		auto lmdb_transaction (store.tx_begin_read ());
@@ -1436,6 +1380,11 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 			rocksdb_store->peer.put (rocksdb_transaction, i->first, i->second);
 		}
 
+		// Bulk transactions bypass the write-ahead log, persist everything before verifying
+		rocksdb_transaction.commit ();
+		rocksdb_store->flush ();
+		rocksdb_transaction.renew ();
+
 		// Compare counts
 		error |= store.peer.count (lmdb_transaction) != rocksdb_store->peer.count (rocksdb_transaction);
 		error |= store.pruned.count (lmdb_transaction) != rocksdb_store->pruned.count (rocksdb_transaction);
@@ -3,6 +3,8 @@
 #include <nano/store/component.hpp>
 #include <nano/store/rep_weight.hpp>
 
+#include <utility>
+
 nano::rep_weights::rep_weights (nano::store::rep_weight & rep_weight_store_a, nano::uint128_t min_weight_a) :
 	rep_weight_store{ rep_weight_store_a },
 	min_weight{ min_weight_a }
@@ -16,6 +18,7 @@ void nano::rep_weights::representation_add (store::write_transaction const & txn
 	put_store (txn_a, rep_a, previous_weight, new_weight);
 	std::unique_lock guard{ mutex };
 	put_cache (rep_a, new_weight);
+	record_change (rep_a);
 }
 
 void nano::rep_weights::representation_add_dual (store::write_transaction const & txn_a, nano::account const & rep_1, nano::uint128_t const & amount_1, nano::account const & rep_2, nano::uint128_t const & amount_2)
@@ -31,6 +34,8 @@ void nano::rep_weights::representation_add_dual (store::write_transaction const
 		std::unique_lock guard{ mutex };
 		put_cache (rep_1, new_weight_1);
 		put_cache (rep_2, new_weight_2);
+		record_change (rep_1);
+		record_change (rep_2);
 	}
 	else
 	{
@@ -68,6 +73,35 @@ void nano::rep_weights::copy_from (nano::rep_weights & other_a)
 	}
 }
 
+void nano::rep_weights::track_changes (bool enable_a)
+{
+	std::unique_lock guard{ mutex };
+	tracking = enable_a;
+	changed.clear ();
+	changes_pending = false;
+}
+
+std::unordered_set<nano::account> nano::rep_weights::take_changes ()
+{
+	// Checked without the lock so consumers polling on hot paths do not contend with ledger writes
+	if (!changes_pending.load ())
+	{
+		return {};
+	}
+	std::unique_lock guard{ mutex };
+	changes_pending = false;
+	return std::exchange (changed, {});
+}
+
+void nano::rep_weights::record_change (nano::account const & account_a)
+{
+	if (tracking)
+	{
+		changed.insert (account_a);
+		changes_pending = true;
+	}
+}
+
 void nano::rep_weights::put_cache (nano::account const & account_a, nano::uint128_union const & representation_a)
 {
 	auto it = rep_amounts.find (account_a);
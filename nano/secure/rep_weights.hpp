@@ -3,9 +3,11 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <atomic>
 #include <memory>
 #include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace nano
 {
@@ -30,10 +32,19 @@ public:
 	void copy_from (rep_weights & other_a);
 	size_t size () const;
 	std::unique_ptr<container_info_component> collect_container_info (std::string const &) const;
+	/** Starts or stops recording representatives whose weight changes through representation_add */
+	void track_changes (bool enable);
+	/** Returns and clears the representatives whose weight changed since the previous call */
+	std::unordered_set<nano::account> take_changes ();
 
 private:
 	mutable std::shared_mutex mutex;
 	std::unordered_map<nano::account, nano::uint128_t> rep_amounts;
+	/** Changed representatives are recorded under the same lock that updates their weight, consumers pick them up in batches */
+	bool tracking{ false };
+	std::unordered_set<nano::account> changed;
+	std::atomic<bool> changes_pending{ false };
+	void record_change (nano::account const & account_a);
 	nano::store::rep_weight & rep_weight_store;
 	nano::uint128_t min_weight;
 	void put_cache (nano::account const & account_a, nano::uint128_union const & representation_a);
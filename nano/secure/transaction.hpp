@@ -71,7 +71,8 @@ public:
 	bool refresh_if_needed (std::chrono::milliseconds max_age = std::chrono::milliseconds{ 500 })
 	{
 		auto now = std::chrono::steady_clock::now ();
-		if (now - start > max_age)
+		// Also refresh early when a higher priority writer is kept waiting
+		if (now - start > max_age || guard.should_yield ())
 		{
 			refresh ();
 			return true;
@@ -0,0 +1,81 @@
+#include <nano/lib/asio.hpp>
+#include <nano/node/transport/tcp_socket.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+/*
+ * Measures socket throughput over loopback for vote sized messages
+ * The asio backend is a build time choice, compare by running this test from a default build and from one with NANO_IO_URING=ON
+ */
+TEST (socket, loopback_throughput)
+{
+	nano::test::system system;
+	auto node = system.add_node ();
+
+	size_t const message_size = 256;
+	size_t const message_count = 1000000;
+
+	boost::asio::ip::tcp::acceptor acceptor (node->io_ctx);
+	boost::asio::ip::tcp::endpoint endpoint (boost::asio::ip::address_v6::loopback (), 0);
+	acceptor.open (endpoint.protocol ());
+	acceptor.bind (endpoint);
+	acceptor.listen (boost::asio::socket_base::max_listen_connections);
+
+	std::atomic<size_t> received_bytes{ 0 };
+	std::atomic<bool> accepted{ false };
+	std::shared_ptr<nano::transport::tcp_socket> server;
+	auto buffer = std::make_shared<std::vector<uint8_t>> (message_size);
+	std::function<void ()> read_next = [&] () {
+		server->async_read (buffer, message_size, [&] (boost::system::error_code const & ec, std::size_t size) {
+			if (!ec)
+			{
+				received_bytes += size;
+				read_next ();
+			}
+		});
+	};
+	acceptor.async_accept ([&] (boost::system::error_code const & ec, boost::asio::ip::tcp::socket socket) {
+		ASSERT_FALSE (ec);
+		auto remote = socket.remote_endpoint ();
+		auto local = socket.local_endpoint ();
+		server = std::make_shared<nano::transport::tcp_socket> (*node, std::move (socket), remote, local);
+		read_next ();
+		accepted = true;
+	});
+
+	std::atomic<bool> connected{ false };
+	auto client = std::make_shared<nano::transport::tcp_socket> (*node);
+	client->async_connect (acceptor.local_endpoint (), [&connected] (boost::system::error_code const & ec) {
+		ASSERT_FALSE (ec);
+		connected = true;
+	});
+	ASSERT_TIMELY (10s, connected && accepted);
+
+	auto const start = std::chrono::steady_clock::now ();
+	for (size_t n = 0; n < message_count; ++n)
+	{
+		// Keep the send queue from overflowing, the socket drops writes beyond its capacity
+		while (client->full ())
+		{
+			std::this_thread::yield ();
+		}
+		client->async_write (nano::shared_const_buffer{ std::vector<uint8_t> (message_size, static_cast<uint8_t> (n)) });
+	}
+	ASSERT_TIMELY_EQ (120s, received_bytes, message_size * message_count);
+	auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	std::cout << "backend: " << nano::asio_backend () << std::endl;
+	std::cout << "messages: " << message_count << " x " << message_size << " bytes in " << elapsed.count () << " ms" << std::endl;
+	std::cout << "throughput: " << (message_count * 1000.0 / std::max<int64_t> (elapsed.count (), 1)) << " messages/s, "
+			  << (message_size * message_count / 1024.0 / 1024.0 * 1000.0 / std::max<int64_t> (elapsed.count (), 1)) << " MiB/s" << std::endl;
+
+	client->close ();
+	server->close ();
+}
@@ -21,6 +21,15 @@ public:
 	std::shared_ptr<nano::block> block;
 	nano::block_sideband sideband;
 };
+/** Block entry with its sideband in the fixed width format used up to store version v24 */
+class block_w_sideband_v24
+{
+public:
+	std::shared_ptr<nano::block> block;
+	nano::block_sideband sideband;
+	/** Entry was already rewritten in the compact format by an interrupted upgrade */
+	bool compact{ false };
+};
 /**
  * Manages block storage and iteration
  */
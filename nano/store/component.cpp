@@ -7,7 +7,7 @@
 #include <nano/store/confirmation_height.hpp>
 #include <nano/store/rep_weight.hpp>
 
-nano::store::component::component (nano::store::block & block_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a, nano::store::rep_weight & rep_weight_a, bool use_noops_a) :
+nano::store::component::component (nano::store::block & block_store_a, nano::store::account & account_store_a, nano::store::pending & pending_store_a, nano::store::online_weight & online_weight_store_a, nano::store::pruned & pruned_store_a, nano::store::peer & peer_store_a, nano::store::confirmation_height & confirmation_height_store_a, nano::store::final_vote & final_vote_store_a, nano::store::version & version_store_a, nano::store::rep_weight & rep_weight_a, bool use_noops_a, nano::store::write_queue_config const & write_queue_config_a) :
 	block (block_store_a),
 	account (account_store_a),
 	pending (pending_store_a),
@@ -17,11 +17,21 @@ nano::store::component::component (nano::store::block & block_store_a, nano::sto
 	confirmation_height (confirmation_height_store_a),
 	final_vote (final_vote_store_a),
 	version (version_store_a),
-	write_queue (use_noops_a),
+	write_queue (use_noops_a, write_queue_config_a),
 	rep_weight (rep_weight_a)
 {
 }
 
+nano::store::write_transaction nano::store::component::tx_begin_write_bulk (std::vector<nano::tables> const & tables_a)
+{
+	return tx_begin_write ({}, tables_a);
+}
+
+void nano::store::component::flush ()
+{
+	// Regular write transactions are durable on commit
+}
+
 /**
  * If using a different store version than the latest then you may need
  * to modify some of the objects in the store to be appropriate for the version before an upgrade.
@@ -54,7 +54,8 @@ namespace store
 		nano::store::final_vote &,
 		nano::store::version &,
 		nano::store::rep_weight &,
-		bool use_noops_a
+		bool use_noops_a,
+		nano::store::write_queue_config const &
 	);
 		// clang-format on
 		virtual ~component () = default;
@@ -71,7 +72,7 @@ namespace store
 		store::pending & pending;
 		store::rep_weight & rep_weight;
 		static int constexpr version_minimum{ 21 };
-		static int constexpr version_current{ 24 };
+		static int constexpr version_current{ 25 };
 
 	public:
 		store::online_weight & online_weight;
@@ -89,6 +90,11 @@ namespace store
 
 		virtual bool copy_db (std::filesystem::path const & destination) = 0;
 		virtual void rebuild_db (write_transaction const & transaction_a) = 0;
+		/** Compacts the database while it is in use, returns true on success. Not applicable to all sub-classes */
+		virtual bool compact ()
+		{
+			return false;
+		}
 
 		/** Not applicable to all sub-classes */
 		virtual void serialize_mdb_tracker (boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
@@ -102,6 +108,14 @@ namespace store
 		/** Start read-only transaction */
 		virtual read_transaction tx_begin_read () const = 0;
 
+		/**
+		 * Start write transaction for bulk loading tables nothing else is accessing, such as during migration.
+		 * Backends may skip concurrency control and durability, writes are only guaranteed durable after flush ()
+		 */
+		virtual write_transaction tx_begin_write_bulk (std::vector<nano::tables> const & tables);
+		/** Persists writes made by bulk transactions */
+		virtual void flush ();
+
 		virtual std::string vendor_get () const = 0;
 	};
 } // namespace store
@@ -185,6 +185,8 @@ public:
 
 	explicit operator block_w_sideband () const;
 
+	explicit operator block_w_sideband_v24 () const;
+
 	explicit operator std::nullptr_t () const
 	{
 		return nullptr;
@@ -80,6 +80,34 @@ nano::store::db_val<T>::operator nano::store::block_w_sideband () const
 	return block_w_sideband;
 }
 
+template <typename T>
+nano::store::db_val<T>::operator nano::store::block_w_sideband_v24 () const
+{
+	nano::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
+	nano::store::block_w_sideband_v24 block_w_sideband;
+	block_w_sideband.block = (nano::deserialize_block (stream));
+	auto const type = block_w_sideband.block->type ();
+	auto const offset = sizeof (nano::block_type) + nano::block::size (type);
+	// Both formats have the same length only if the varint fields fill the fixed width height, or timestamp for open blocks
+	// The leading varint byte then has its continuation bit set, which a fixed width value never has
+	block_w_sideband.compact = size () - offset != nano::block_sideband::size_v24 (type);
+	if (!block_w_sideband.compact)
+	{
+		auto error = block_w_sideband.sideband.deserialize_v24 (stream, type);
+		auto const leading = type == nano::block_type::open ? block_w_sideband.sideband.timestamp : block_w_sideband.sideband.height;
+		block_w_sideband.compact = (leading >> 63) != 0;
+		release_assert (block_w_sideband.compact || !error);
+	}
+	if (block_w_sideband.compact)
+	{
+		nano::bufferstream compact_stream (reinterpret_cast<uint8_t const *> (data ()) + offset, size () - offset);
+		auto error = block_w_sideband.sideband.deserialize (compact_stream, type);
+		release_assert (!error);
+	}
+	block_w_sideband.block->sideband_set (block_w_sideband.sideband);
+	return block_w_sideband;
+}
+
 template <typename T>
 nano::store::db_val<T>::operator nano::pending_info () const
 {
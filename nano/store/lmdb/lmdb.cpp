@@ -14,7 +14,7 @@
 
 #include <queue>
 
-nano::store::lmdb::component::component (nano::logger & logger_a, std::filesystem::path const & path_a, nano::ledger_constants & constants, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, nano::lmdb_config const & lmdb_config_a, bool backup_before_upgrade_a) :
+nano::store::lmdb::component::component (nano::logger & logger_a, std::filesystem::path const & path_a, nano::ledger_constants & constants, nano::txn_tracking_config const & txn_tracking_config_a, std::chrono::milliseconds block_processor_batch_max_time_a, nano::lmdb_config const & lmdb_config_a, bool backup_before_upgrade_a, nano::store::write_queue_config const & write_queue_config_a) :
 	// clang-format off
 	nano::store::component{
 		block_store,
@@ -27,7 +27,8 @@ nano::store::lmdb::component::component (nano::logger & logger_a, std::filesyste
 		final_vote_store,
 		version_store,
 		rep_weight_store,
-		false // write_queue use_noops
+		false, // write_queue use_noops
+		write_queue_config_a
 	},
 	// clang-format on
 	block_store{ *this },
@@ -41,6 +42,8 @@ nano::store::lmdb::component::component (nano::logger & logger_a, std::filesyste
 	version_store{ *this },
 	rep_weight_store{ *this },
 	logger{ logger_a },
+	path{ path_a },
+	lmdb_config{ lmdb_config_a },
 	env (error, path_a, nano::store::lmdb::env::options::make ().set_config (lmdb_config_a).set_use_no_mem_init (true)),
 	mdb_txn_tracker (logger_a, txn_tracking_config_a, block_processor_batch_max_time_a),
 	txn_tracking_enabled (txn_tracking_config_a.enable)
@@ -126,16 +129,7 @@ bool nano::store::lmdb::component::vacuum_after_upgrade (std::filesystem::path c
 		// Replace the ledger file with the vacuumed one
 		std::filesystem::rename (vacuum_path, path_a);
 
-		// Set up the environment again
-		auto options = nano::store::lmdb::env::options::make ()
-					   .set_config (lmdb_config_a)
-					   .set_use_no_mem_init (true);
-		env.init (error, path_a, options);
-		if (!error)
-		{
-			auto transaction (tx_begin_read ());
-			open_databases (error, transaction, 0);
-		}
+		reopen (path_a, lmdb_config_a);
 	}
 	else
 	{
@@ -145,6 +139,172 @@ bool nano::store::lmdb::component::vacuum_after_upgrade (std::filesystem::path c
 	return vacuum_success;
 }
 
+void nano::store::lmdb::component::reopen (std::filesystem::path const & path_a, nano::lmdb_config const & lmdb_config_a)
+{
+	// Set up the environment again
+	auto options = nano::store::lmdb::env::options::make ()
+				   .set_config (lmdb_config_a)
+				   .set_use_no_mem_init (true);
+	env.init (error, path_a, options);
+	if (!error)
+	{
+		auto transaction (tx_begin_read ());
+		open_databases (error, transaction, 0);
+	}
+}
+
+bool nano::store::lmdb::component::compact ()
+{
+	if (!env.gate_enabled ())
+	{
+		logger.warn (nano::log::type::lmdb, "Ledger compaction skipped, compaction_interval is not configured");
+		return false;
+	}
+	auto compact_path = path.parent_path () / "compacting.ldb";
+	std::filesystem::remove (compact_path);
+	auto const size_before = std::filesystem::file_size (path);
+
+	// Writes started before journaling would be missing from the journal but could commit after the copy snapshot, let them finish first
+	if (!env.block_writes (compaction_wait_timeout))
+	{
+		env.unblock ();
+		logger.warn (nano::log::type::lmdb, "Ledger compaction skipped, write transactions did not finish in time");
+		return false;
+	}
+	{
+		nano::lock_guard<nano::mutex> guard{ journal_mutex };
+		journal_bytes = 0;
+		journal_overflow = false;
+		journaling = true;
+	}
+	env.unblock ();
+
+	logger.info (nano::log::type::lmdb, "Ledger compaction in progress...");
+
+	// The copy is taken from a read snapshot, everything written after it is in the journal
+	auto success = copy_db (compact_path);
+	if (success)
+	{
+		success = env.block_writes (compaction_wait_timeout);
+		if (!success)
+		{
+			logger.warn (nano::log::type::lmdb, "Ledger compaction aborted, write transactions did not finish in time");
+		}
+		else if (journal_overflow)
+		{
+			success = false;
+			logger.warn (nano::log::type::lmdb, "Ledger compaction aborted, writes made during the copy exceeded {} MB", compaction_journal_max_bytes / 1024 / 1024);
+		}
+		if (success)
+		{
+			success = swap_compacted (compact_path);
+		}
+	}
+	else
+	{
+		logger.error (nano::log::type::lmdb, "Ledger compaction failed, please ensure enough disk space is available for a copy of the database");
+	}
+
+	if (!success)
+	{
+		// The copy can be in an inconsistent state if there wasn't enough space to create it
+		std::filesystem::remove (compact_path);
+	}
+	{
+		nano::lock_guard<nano::mutex> guard{ journal_mutex };
+		journaling = false;
+		journal = {};
+	}
+	env.unblock ();
+
+	if (success)
+	{
+		logger.info (nano::log::type::lmdb, "Ledger compaction completed, size reduced from {} MB to {} MB", size_before / 1024 / 1024, std::filesystem::file_size (path) / 1024 / 1024);
+	}
+	return success;
+}
+
+bool nano::store::lmdb::component::swap_compacted (std::filesystem::path const & compact_path)
+{
+	// The previous environment keeps its lock file open until its readers finish, move it aside so the new environment gets its own
+	auto lock_path = path;
+	lock_path += "-lock";
+	auto retired_lock = path.parent_path () / ("retired" + std::to_string (compactions++) + ".ldb-lock");
+	std::error_code ec;
+	std::filesystem::rename (lock_path, retired_lock, ec);
+	if (!ec)
+	{
+		std::filesystem::rename (compact_path, path, ec);
+		if (ec)
+		{
+			std::filesystem::rename (retired_lock, lock_path, ec);
+		}
+	}
+	if (ec)
+	{
+		// Platforms that cannot replace files in use keep the current environment
+		logger.warn (nano::log::type::lmdb, "Ledger compaction aborted, unable to replace the database file: {}", ec.message ());
+		return false;
+	}
+
+	// Existing read transactions continue in the previous environment which still maps the replaced file
+	auto options = nano::store::lmdb::env::options::make ()
+				   .set_config (lmdb_config)
+				   .set_use_no_mem_init (true);
+	bool error_l{ false };
+	nano::store::lmdb::env compacted (error_l, path, options);
+	release_assert (!error_l, "Unable to open the compacted ledger database");
+	env.block_reads ();
+	env.replace (std::exchange (compacted.environment, nullptr), retired_lock);
+
+	std::vector<journal_entry> entries;
+	{
+		nano::lock_guard<nano::mutex> guard{ journal_mutex };
+		journaling = false;
+		entries.swap (journal);
+	}
+	{
+		auto handles = [this] () {
+			std::vector<MDB_dbi> result;
+			for (auto table : { tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::rep_weights })
+			{
+				result.push_back (table_to_dbi (table));
+			}
+			return result;
+		};
+		auto const handles_before = handles ();
+		auto transaction = tx_begin_write ();
+		// New read transactions stay blocked until the tables are opened in the new environment
+		open_databases (error, transaction, 0);
+		release_assert (!error, "Unable to reopen the ledger database after compaction");
+		// Tables are opened in the same order, handles used by read transactions in the previous environment stay valid
+		debug_assert (handles () == handles_before);
+		for (auto & entry : entries)
+		{
+			auto dbi = table_to_dbi (entry.table);
+			nano::store::lmdb::db_val key{ entry.key.size (), entry.key.data () };
+			switch (entry.op)
+			{
+				case journal_entry::operation::put:
+					release_assert_success (mdb_put (env.tx (transaction), dbi, key, nano::store::lmdb::db_val{ entry.value.size (), entry.value.data () }, 0));
+					break;
+				case journal_entry::operation::del:
+				{
+					// Deletions made before the copy snapshot are already reflected in it
+					auto status = mdb_del (env.tx (transaction), dbi, key, nullptr);
+					release_assert (status == MDB_SUCCESS || status == MDB_NOTFOUND);
+					break;
+				}
+				case journal_entry::operation::drop:
+					release_assert_success (mdb_drop (env.tx (transaction), dbi, 0));
+					break;
+			}
+		}
+	}
+	logger.info (nano::log::type::lmdb, "Replayed {} writes made during ledger compaction", entries.size ());
+	return true;
+}
+
 void nano::store::lmdb::component::serialize_mdb_tracker (boost::property_tree::ptree & json, std::chrono::milliseconds min_read_time, std::chrono::milliseconds min_write_time)
 {
 	mdb_txn_tracker.serialize_json (json, min_read_time, min_write_time);
@@ -230,6 +390,10 @@ bool nano::store::lmdb::component::do_upgrades (store::write_transaction & trans
 			upgrade_v23_to_v24 (transaction);
 			[[fallthrough]];
 		case 24:
+			upgrade_v24_to_v25 (transaction);
+			needs_vacuuming = true; // Every block entry shrinks, reclaim the freed pages
+			[[fallthrough]];
+		case 25:
 			break;
 		default:
 			logger.critical (nano::log::type::lmdb, "The version of the ledger ({}) is too high for this node", version_l);
@@ -321,6 +485,71 @@ void nano::store::lmdb::component::upgrade_v23_to_v24 (store::write_transaction
 	logger.info (nano::log::type::lmdb, "Upgrading database from v23 to v24 completed");
 }
 
+// Rewrite all block entries with the compact sideband format
+void nano::store::lmdb::component::upgrade_v24_to_v25 (store::write_transaction & transaction)
+{
+	logger.info (nano::log::type::lmdb, "Upgrading database from v24 to v25...");
+
+	// Entries are read in batches with the write transaction so no older snapshot of the blocks table has to be retained
+	size_t const batch_size = 100000;
+
+	std::vector<std::pair<nano::block_hash, nano::store::block_w_sideband_v24>> batch;
+	std::optional<nano::block_hash> last;
+	uint64_t processed = 0;
+	uint64_t size_before = 0;
+	uint64_t size_after = 0;
+	do
+	{
+		batch.clear ();
+		{
+			// Manually create v24 compatible iterator to read blocks
+			auto it = last ? make_iterator<nano::block_hash, nano::store::block_w_sideband_v24> (transaction, tables::blocks, nano::store::lmdb::db_val{ *last }) : make_iterator<nano::block_hash, nano::store::block_w_sideband_v24> (transaction, tables::blocks);
+			auto const end = store::iterator<nano::block_hash, nano::store::block_w_sideband_v24> (nullptr);
+			if (last && it != end && it->first == *last)
+			{
+				++it;
+			}
+			for (; it != end && batch.size () < batch_size; ++it)
+			{
+				batch.emplace_back (it->first, it->second);
+			}
+		}
+		for (auto const & [hash, entry] : batch)
+		{
+			auto const type = entry.block->type ();
+			auto const size = sizeof (nano::block_type) + nano::block::size (type);
+			if (entry.compact)
+			{
+				// Batches committed before an interrupted upgrade are already converted
+				size_before += size + entry.sideband.size (type);
+				size_after += size + entry.sideband.size (type);
+				continue;
+			}
+			std::vector<uint8_t> vector;
+			{
+				nano::vectorstream stream (vector);
+				nano::serialize_block (stream, *entry.block);
+				entry.sideband.serialize (stream, type);
+			}
+			block_store.raw_put (transaction, vector, hash);
+			size_before += size + nano::block_sideband::size_v24 (type);
+			size_after += vector.size ();
+		}
+		if (!batch.empty ())
+		{
+			last = batch.back ().first;
+			processed += batch.size ();
+			logger.info (nano::log::type::lmdb, "Processed {} blocks", processed);
+			transaction.refresh (); // Refresh to prevent excessive memory usage
+		}
+	} while (batch.size () == batch_size);
+
+	logger.info (nano::log::type::lmdb, "Done processing {} blocks, entries reduced from {} to {} bytes", processed, size_before, size_after);
+	version.put (transaction, 25);
+
+	logger.info (nano::log::type::lmdb, "Upgrading database from v24 to v25 completed");
+}
+
 /** Takes a filepath, appends '_backup_<timestamp>' to the end (but before any extension) and saves that file in the same directory */
 void nano::store::lmdb::component::create_backup_file (nano::store::lmdb::env & env_a, std::filesystem::path const & filepath_a, nano::logger & logger)
 {
@@ -363,17 +592,68 @@ int nano::store::lmdb::component::get (store::transaction const & transaction_a,
 
 int nano::store::lmdb::component::put (store::write_transaction const & transaction_a, tables table_a, nano::store::lmdb::db_val const & key_a, nano::store::lmdb::db_val const & value_a) const
 {
-	return (mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0));
+	auto status = mdb_put (env.tx (transaction_a), table_to_dbi (table_a), key_a, value_a, 0);
+	if (journaling && status == MDB_SUCCESS)
+	{
+		journal_write (table_a, key_a, &value_a);
+	}
+	return status;
 }
 
 int nano::store::lmdb::component::del (store::write_transaction const & transaction_a, tables table_a, nano::store::lmdb::db_val const & key_a) const
 {
-	return (mdb_del (env.tx (transaction_a), table_to_dbi (table_a), key_a, nullptr));
+	auto status = mdb_del (env.tx (transaction_a), table_to_dbi (table_a), key_a, nullptr);
+	if (journaling && status == MDB_SUCCESS)
+	{
+		journal_write (table_a, key_a, nullptr);
+	}
+	return status;
 }
 
 int nano::store::lmdb::component::drop (store::write_transaction const & transaction_a, tables table_a)
 {
-	return clear (transaction_a, table_to_dbi (table_a));
+	auto status = clear (transaction_a, table_to_dbi (table_a));
+	if (journaling && status == MDB_SUCCESS)
+	{
+		journal_drop (table_a);
+	}
+	return status;
+}
+
+void nano::store::lmdb::component::journal_write (tables table_a, nano::store::lmdb::db_val const & key_a, nano::store::lmdb::db_val const * value_a) const
+{
+	auto key = static_cast<uint8_t const *> (key_a.data ());
+	journal_entry entry{ value_a != nullptr ? journal_entry::operation::put : journal_entry::operation::del, table_a, { key, key + key_a.size () }, {} };
+	if (value_a != nullptr)
+	{
+		auto value = static_cast<uint8_t const *> (value_a->data ());
+		entry.value.assign (value, value + value_a->size ());
+	}
+	journal_push (std::move (entry));
+}
+
+void nano::store::lmdb::component::journal_drop (tables table_a) const
+{
+	journal_push ({ journal_entry::operation::drop, table_a, {}, {} });
+}
+
+void nano::store::lmdb::component::journal_push (journal_entry && entry) const
+{
+	nano::lock_guard<nano::mutex> guard{ journal_mutex };
+	if (!journaling)
+	{
+		return; // Stopped after an overflow
+	}
+	journal_bytes += sizeof (journal_entry) + entry.key.size () + entry.value.size ();
+	if (journal_bytes > compaction_journal_max_bytes)
+	{
+		// The compaction is aborted once the copy finishes, release the memory right away
+		journal_overflow = true;
+		journaling = false;
+		journal = {};
+		return;
+	}
+	journal.push_back (std::move (entry));
 }
 
 int nano::store::lmdb::component::clear (store::write_transaction const & transaction_a, MDB_dbi handle_a)
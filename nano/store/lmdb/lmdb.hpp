@@ -26,6 +26,9 @@
 
 #include <lmdb/libraries/liblmdb/lmdb.h>
 
+#include <atomic>
+#include <vector>
+
 namespace nano
 {
 class logging_mt;
@@ -63,7 +66,7 @@ private:
 	friend class nano::store::lmdb::rep_weight;
 
 public:
-	component (nano::logger &, std::filesystem::path const &, nano::ledger_constants & constants, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), nano::lmdb_config const & lmdb_config_a = nano::lmdb_config{}, bool backup_before_upgrade = false);
+	component (nano::logger &, std::filesystem::path const &, nano::ledger_constants & constants, nano::txn_tracking_config const & txn_tracking_config_a = nano::txn_tracking_config{}, std::chrono::milliseconds block_processor_batch_max_time_a = std::chrono::milliseconds (5000), nano::lmdb_config const & lmdb_config_a = nano::lmdb_config{}, bool backup_before_upgrade = false, nano::store::write_queue_config const & write_queue_config_a = nano::store::write_queue_config{});
 	store::write_transaction tx_begin_write (std::vector<nano::tables> const & tables_requiring_lock = {}, std::vector<nano::tables> const & tables_no_lock = {}) override;
 	store::read_transaction tx_begin_read () const override;
 
@@ -80,6 +83,8 @@ public:
 private:
 	nano::logger & logger;
 	bool error{ false };
+	std::filesystem::path const path;
+	nano::lmdb_config const lmdb_config;
 
 public:
 	nano::store::lmdb::env env;
@@ -92,6 +97,12 @@ public:
 
 	bool copy_db (std::filesystem::path const & destination_file) override;
 	void rebuild_db (store::write_transaction const & transaction_a) override;
+	/**
+	 * Copies the database with free pages omitted and swaps it in place of the current one.
+	 * The copy is taken from a read snapshot while writes continue, they are journaled and replayed onto the copy.
+	 * Writes and new reads are only paused while the journal is replayed, existing reads finish in the previous environment.
+	 */
+	bool compact () override;
 
 	template <typename Key, typename Value>
 	store::iterator<Key, Value> make_iterator (store::transaction const & transaction_a, tables table_a, bool const direction_asc = true) const
@@ -115,6 +126,7 @@ private:
 	void upgrade_v21_to_v22 (store::write_transaction &);
 	void upgrade_v22_to_v23 (store::write_transaction &);
 	void upgrade_v23_to_v24 (store::write_transaction &);
+	void upgrade_v24_to_v25 (store::write_transaction &);
 
 	void open_databases (bool &, store::transaction const &, unsigned);
 
@@ -141,6 +153,41 @@ private:
 	uint64_t count (store::transaction const & transaction_a, tables table_a) const override;
 
 	bool vacuum_after_upgrade (std::filesystem::path const & path_a, nano::lmdb_config const & lmdb_config_a);
+	/** Reopens the environment after the database file was replaced, no transactions may be open */
+	void reopen (std::filesystem::path const & path_a, nano::lmdb_config const & lmdb_config_a);
+
+	// How long compaction waits for write transactions to finish before giving up
+	static std::chrono::seconds constexpr compaction_wait_timeout{ 5 };
+	// Compaction is aborted when the writes journaled during the copy take up more memory than this
+	static std::size_t constexpr compaction_journal_max_bytes{ 256 * 1024 * 1024 };
+
+	/** Replays the journal onto the compacted copy and makes it the current environment, writes have to be blocked */
+	bool swap_compacted (std::filesystem::path const & compact_path);
+	void journal_write (tables, nano::store::lmdb::db_val const & key, nano::store::lmdb::db_val const * value) const;
+	void journal_drop (tables) const;
+
+	class journal_entry
+	{
+	public:
+		enum class operation
+		{
+			put,
+			del,
+			drop
+		};
+		operation op;
+		nano::tables table;
+		std::vector<uint8_t> key;
+		std::vector<uint8_t> value;
+	};
+	void journal_push (journal_entry &&) const;
+	// Writes are journaled while compaction copies the database
+	mutable std::atomic<bool> journaling{ false };
+	mutable nano::mutex journal_mutex;
+	mutable std::vector<journal_entry> journal;
+	mutable std::size_t journal_bytes{ 0 };
+	mutable std::atomic<bool> journal_overflow{ false };
+	unsigned compactions{ 0 };
 
 	class upgrade_counters
 	{
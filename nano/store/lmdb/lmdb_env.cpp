@@ -3,6 +3,8 @@
 
 #include <boost/system/error_code.hpp>
 
+#include <utility>
+
 nano::store::lmdb::env::env (bool & error_a, std::filesystem::path const & path_a, nano::store::lmdb::env::options options_a)
 {
 	init (error_a, path_a, options_a);
@@ -62,6 +64,11 @@ void nano::store::lmdb::env::init (bool & error_a, std::filesystem::path const &
 			}
 			release_assert (status4 == 0);
 			error_a = status4 != 0;
+
+			gated = options_a.config.compaction_interval.count () > 0;
+			instances.push_back (std::make_unique<env_instance> ());
+			instances.back ()->environment = environment;
+			current = instances.back ().get ();
 		}
 		else
 		{
@@ -84,6 +91,14 @@ nano::store::lmdb::env::~env ()
 		mdb_env_sync (environment, true);
 		mdb_env_close (environment);
 	}
+	// Read transactions never outlive the store, environments replaced by compaction are unused by now
+	for (auto const & instance : instances)
+	{
+		if (instance->retired)
+		{
+			close_retired (*instance);
+		}
+	}
 }
 
 nano::store::lmdb::env::operator MDB_env * () const
@@ -106,3 +121,131 @@ MDB_txn * nano::store::lmdb::env::tx (store::transaction const & transaction_a)
 	debug_assert (transaction_a.store_id () == store_id);
 	return static_cast<MDB_txn *> (transaction_a.get_handle ());
 }
+
+bool nano::store::lmdb::env::gate_enabled () const
+{
+	return gated;
+}
+
+auto nano::store::lmdb::env::read_enter () const -> env_instance *
+{
+	auto instance = current.load ();
+	if (!gated)
+	{
+		return instance;
+	}
+	// The reader is counted before checking for a swap, replace () then either sees the reader or the reader sees the swap
+	++instance->readers;
+	if (!reads_blocked && current.load () == instance)
+	{
+		return instance;
+	}
+	read_exit (instance);
+
+	nano::unique_lock<nano::mutex> lock{ gate_mutex };
+	gate_condition.wait (lock, [this] () { return !reads_blocked || gate_owner == std::this_thread::get_id (); });
+	instance = current.load ();
+	++instance->readers;
+	return instance;
+}
+
+void nano::store::lmdb::env::read_exit (env_instance * instance) const
+{
+	if (!gated)
+	{
+		return;
+	}
+	if (--instance->readers == 0 && instance->retired)
+	{
+		close_retired (*instance);
+	}
+}
+
+void nano::store::lmdb::env::write_enter () const
+{
+	if (!gated)
+	{
+		return;
+	}
+	nano::unique_lock<nano::mutex> lock{ gate_mutex };
+	gate_condition.wait (lock, [this] () { return !writes_blocked || gate_owner == std::this_thread::get_id (); });
+	++writers;
+}
+
+void nano::store::lmdb::env::write_exit () const
+{
+	if (!gated)
+	{
+		return;
+	}
+	{
+		nano::lock_guard<nano::mutex> guard{ gate_mutex };
+		debug_assert (writers > 0);
+		--writers;
+	}
+	gate_condition.notify_all ();
+}
+
+bool nano::store::lmdb::env::block_writes (std::chrono::milliseconds timeout)
+{
+	nano::unique_lock<nano::mutex> lock{ gate_mutex };
+	debug_assert (!writes_blocked);
+	writes_blocked = true;
+	gate_owner = std::this_thread::get_id ();
+	return gate_condition.wait_for (lock, timeout, [this] () { return writers == 0; });
+}
+
+void nano::store::lmdb::env::block_reads ()
+{
+	nano::lock_guard<nano::mutex> guard{ gate_mutex };
+	debug_assert (writes_blocked && gate_owner == std::this_thread::get_id ());
+	reads_blocked = true;
+}
+
+void nano::store::lmdb::env::unblock ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ gate_mutex };
+		writes_blocked = false;
+		reads_blocked = false;
+		gate_owner = {};
+	}
+	gate_condition.notify_all ();
+}
+
+uint64_t nano::store::lmdb::env::generation () const
+{
+	return generation_m;
+}
+
+void nano::store::lmdb::env::replace (MDB_env * environment_a, std::filesystem::path const & retired_lock_a)
+{
+	auto instance = std::make_unique<env_instance> ();
+	instance->environment = environment_a;
+	env_instance * previous = nullptr;
+	{
+		nano::lock_guard<nano::mutex> guard{ gate_mutex };
+		debug_assert (gated && writes_blocked && reads_blocked && gate_owner == std::this_thread::get_id ());
+		previous = current.exchange (instance.get ());
+		instances.push_back (std::move (instance));
+		environment = environment_a;
+		previous->retired_lock = retired_lock_a;
+		previous->retired = true;
+		++generation_m;
+	}
+	if (previous->readers == 0)
+	{
+		close_retired (*previous);
+	}
+}
+
+void nano::store::lmdb::env::close_retired (env_instance & instance) const
+{
+	// Both the last reader and replace () can see the environment unused, only one of them closes it
+	if (!instance.closed.exchange (true))
+	{
+		mdb_env_close (instance.environment);
+		std::error_code ec;
+		std::filesystem::remove (instance.retired_lock, ec);
+	}
+}
@@ -2,11 +2,30 @@
 
 #include <nano/lib/id_dispenser.hpp>
 #include <nano/lib/lmdbconfig.hpp>
+#include <nano/lib/locks.hpp>
 #include <nano/store/component.hpp>
 #include <nano/store/lmdb/transaction_impl.hpp>
 
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
 namespace nano::store::lmdb
 {
+/**
+ * Environment handle shared with the read transactions started in it, replaced environments stay open until their last reader is released
+ */
+class env_instance final
+{
+public:
+	MDB_env * environment{ nullptr };
+	std::atomic<unsigned> readers{ 0 };
+	std::atomic<bool> retired{ false };
+	std::atomic<bool> closed{ false };
+	std::filesystem::path retired_lock; // Written before `retired` is set
+};
+
 /**
  * RAII wrapper for MDB_env
  */
@@ -64,5 +83,46 @@ public:
 	MDB_txn * tx (store::transaction const & transaction_a) const;
 	MDB_env * environment;
 	nano::id_t const store_id{ nano::next_id () };
+
+public: // Transaction gate, allows swapping the environment while in use
+	/** The gate is only enabled when compaction is configured, otherwise transactions are not tracked */
+	bool gate_enabled () const;
+	/**
+	 * Read transactions are tracked for their whole lifetime as their handles belong to the environment
+	 * Returns the instance the transaction has to be started in, lock free unless a swap is pending
+	 */
+	env_instance * read_enter () const;
+	void read_exit (env_instance *) const;
+	/** Write transactions are tracked while active, a new handle is created on every renewal */
+	void write_enter () const;
+	void write_exit () const;
+	/** Increased whenever the environment is replaced, read transactions move to the new environment on renewal */
+	uint64_t generation () const;
+
+	/** Blocks new write transactions and waits for active ones to finish, returns false on timeout */
+	bool block_writes (std::chrono::milliseconds timeout);
+	/** Blocks new read transactions without waiting for existing ones, writes have to be blocked by the same thread */
+	void block_reads ();
+	void unblock ();
+	/**
+	 * Makes \p environment_a current, writes have to be blocked by the calling thread
+	 * The previous environment is closed once its last read transaction is released, \p retired_lock_a is removed along with it
+	 */
+	void replace (MDB_env * environment_a, std::filesystem::path const & retired_lock_a);
+
+private:
+	void close_retired (env_instance &) const;
+
+	bool gated{ false };
+	mutable nano::mutex gate_mutex;
+	mutable nano::condition_variable gate_condition;
+	mutable unsigned writers{ 0 };
+	bool writes_blocked{ false };
+	std::atomic<bool> reads_blocked{ false };
+	std::thread::id gate_owner; // Thread blocking the gate, never blocked itself so it can reopen the environment
+	std::atomic<uint64_t> generation_m{ 0 };
+	std::atomic<env_instance *> current{ nullptr };
+	// Every environment opened by this wrapper, kept until destruction as a reader may still hold a pointer to a replaced one
+	std::vector<std::unique_ptr<env_instance>> instances;
 };
 } // namespace nano::store::lmdb
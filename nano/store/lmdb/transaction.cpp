@@ -37,10 +37,10 @@ private:
 
 nano::store::lmdb::read_transaction_impl::read_transaction_impl (nano::store::lmdb::env const & environment_a, nano::store::lmdb::txn_callbacks txn_callbacks_a) :
 	store::read_transaction_impl (environment_a.store_id),
+	env (environment_a),
 	txn_callbacks (txn_callbacks_a)
 {
-	auto status (mdb_txn_begin (environment_a, nullptr, MDB_RDONLY, &handle));
-	release_assert (status == 0);
+	begin ();
 	txn_callbacks.txn_start (this);
 }
 
@@ -50,6 +50,7 @@ nano::store::lmdb::read_transaction_impl::~read_transaction_impl ()
 	auto status (mdb_txn_commit (handle));
 	release_assert (status == MDB_SUCCESS);
 	txn_callbacks.txn_end (this);
+	env.read_exit (instance);
 }
 
 void nano::store::lmdb::read_transaction_impl::reset ()
@@ -60,11 +61,30 @@ void nano::store::lmdb::read_transaction_impl::reset ()
 
 void nano::store::lmdb::read_transaction_impl::renew ()
 {
-	auto status (mdb_txn_renew (handle));
-	release_assert (status == 0);
+	if (generation != env.generation ())
+	{
+		// The environment was replaced by compaction while this transaction was reset, continue in the current one
+		mdb_txn_abort (handle);
+		env.read_exit (instance);
+		begin ();
+	}
+	else
+	{
+		auto status (mdb_txn_renew (handle));
+		release_assert (status == 0);
+	}
 	txn_callbacks.txn_start (this);
 }
 
+void nano::store::lmdb::read_transaction_impl::begin ()
+{
+	// Read before entering, a concurrent replacement can then only cause an unneeded move on the next renewal
+	generation = env.generation ();
+	instance = env.read_enter ();
+	auto status (mdb_txn_begin (instance->environment, nullptr, MDB_RDONLY, &handle));
+	release_assert (status == 0);
+}
+
 void * nano::store::lmdb::read_transaction_impl::get_handle () const
 {
 	return handle;
@@ -93,12 +113,14 @@ void nano::store::lmdb::write_transaction_impl::commit ()
 			release_assert (false && "Unable to write to the LMDB database", mdb_strerror (status));
 		}
 		txn_callbacks.txn_end (this);
+		env.write_exit ();
 		active = false;
 	}
 }
 
 void nano::store::lmdb::write_transaction_impl::renew ()
 {
+	env.write_enter ();
 	auto status (mdb_txn_begin (env, nullptr, 0, &handle));
 	release_assert (status == MDB_SUCCESS, mdb_strerror (status));
 	txn_callbacks.txn_start (this);
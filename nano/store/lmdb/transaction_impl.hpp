@@ -15,6 +15,7 @@
 namespace nano::store::lmdb
 {
 class env;
+class env_instance;
 }
 
 namespace nano::store::lmdb
@@ -35,7 +36,14 @@ public:
 	void renew () override;
 	void * get_handle () const override;
 	MDB_txn * handle;
+	nano::store::lmdb::env const & env;
 	lmdb::txn_callbacks txn_callbacks;
+
+private:
+	void begin ();
+	/** Environment the handle belongs to, differs from the current one after compaction until renewed */
+	env_instance * instance;
+	uint64_t generation;
 };
 
 class write_transaction_impl final : public store::write_transaction_impl
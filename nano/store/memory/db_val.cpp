@@ -0,0 +1,25 @@
+#include <nano/store/memory/db_val.hpp>
+
+template <>
+void * nano::store::memory::db_val::data () const
+{
+	return value.data;
+}
+
+template <>
+std::size_t nano::store::memory::db_val::size () const
+{
+	return value.size;
+}
+
+template <>
+nano::store::memory::db_val::db_val (std::size_t size_a, void * data_a) :
+	value{ data_a, size_a }
+{
+}
+
+template <>
+void nano::store::memory::db_val::convert_buffer_to_value ()
+{
+	value = { buffer->data (), buffer->size () };
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <nano/store/db_val.hpp>
+
+#include <cstddef>
+
+namespace nano::store::memory
+{
+/**
+ * Non-owning view of a key or value stored by the in-memory backend
+ */
+class slice
+{
+public:
+	void * data{ nullptr };
+	std::size_t size{ 0 };
+};
+
+using db_val = store::db_val<slice>;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <nano/store/component.hpp>
+#include <nano/store/iterator.hpp>
+#include <nano/store/memory/db_val.hpp>
+#include <nano/store/memory/table.hpp>
+#include <nano/store/transaction.hpp>
+
+#include <shared_mutex>
+
+namespace nano::store::memory
+{
+/**
+ * Iterates the entries of a table visible at the sequence of the transaction.
+ * The table lock is only held while moving the cursor, entries visible to a live transaction are never erased.
+ */
+template <typename T, typename U>
+class iterator : public iterator_impl<T, U>
+{
+public:
+	iterator (nano::store::memory::table const & table_a, std::shared_mutex & mutex_a, store::transaction const & transaction_a, uint64_t sequence_a, db_val const * val_a, bool const direction_asc) :
+		nano::store::iterator_impl<T, U> (transaction_a),
+		table{ table_a },
+		mutex{ mutex_a },
+		sequence{ sequence_a },
+		cursor{ table_a.entries.end () }
+	{
+		std::shared_lock lock{ mutex };
+		if (val_a)
+		{
+			auto key = static_cast<uint8_t const *> (val_a->data ());
+			cursor = table.entries.lower_bound (nano::store::memory::table::key_t (key, key + val_a->size ()));
+			seek_next ();
+		}
+		else if (direction_asc)
+		{
+			cursor = table.entries.begin ();
+			seek_next ();
+		}
+		else
+		{
+			seek_prev ();
+		}
+	}
+
+	iterator (nano::store::memory::iterator<T, U> const &) = delete;
+
+	store::iterator_impl<T, U> & operator++ () override
+	{
+		std::shared_lock lock{ mutex };
+		if (cursor != table.entries.end ())
+		{
+			++cursor;
+			seek_next ();
+		}
+		return *this;
+	}
+
+	store::iterator_impl<T, U> & operator-- () override
+	{
+		std::shared_lock lock{ mutex };
+		seek_prev ();
+		return *this;
+	}
+
+	std::pair<nano::store::memory::db_val, nano::store::memory::db_val> * operator->()
+	{
+		return &current;
+	}
+
+	bool operator== (store::iterator_impl<T, U> const & base_a) const override
+	{
+		auto const other_a (boost::polymorphic_downcast<nano::store::memory::iterator<T, U> const *> (&base_a));
+		debug_assert (&table == &other_a->table);
+		return cursor == other_a->cursor;
+	}
+
+	bool is_end_sentinal () const override
+	{
+		return current.first.size () == 0;
+	}
+
+	void fill (std::pair<T, U> & value_a) const override
+	{
+		if (current.first.size () != 0)
+		{
+			value_a.first = static_cast<T> (current.first);
+		}
+		else
+		{
+			value_a.first = T ();
+		}
+		if (current.second.size () != 0)
+		{
+			value_a.second = static_cast<U> (current.second);
+		}
+		else
+		{
+			value_a.second = U ();
+		}
+	}
+
+	void clear ()
+	{
+		cursor = table.entries.end ();
+		current.first = nano::store::memory::db_val{};
+		current.second = nano::store::memory::db_val{};
+		debug_assert (is_end_sentinal ());
+	}
+
+	store::iterator_impl<T, U> & operator= (store::iterator_impl<T, U> const &) = delete;
+
+private:
+	// Moves forward from the cursor to the first entry visible at our sequence, must hold the table lock
+	void seek_next ()
+	{
+		while (cursor != table.entries.end () && table.visible (cursor->second, sequence) == nullptr)
+		{
+			++cursor;
+		}
+		load ();
+	}
+
+	// Moves backward from the cursor to the first entry visible at our sequence, must hold the table lock
+	void seek_prev ()
+	{
+		do
+		{
+			if (cursor == table.entries.begin ())
+			{
+				clear ();
+				return;
+			}
+			--cursor;
+		} while (table.visible (cursor->second, sequence) == nullptr);
+		load ();
+	}
+
+	void load ()
+	{
+		if (cursor == table.entries.end ())
+		{
+			clear ();
+			return;
+		}
+		auto const & key = cursor->first;
+		current.first = nano::store::memory::db_val{ key.size (), const_cast<uint8_t *> (key.data ()) };
+		// Share ownership of the value so it outlives any later overwrite of this entry
+		current.second.buffer = table.visible (cursor->second, sequence);
+		current.second.convert_buffer_to_value ();
+		if (current.first.size () != sizeof (T))
+		{
+			clear ();
+		}
+	}
+
+	nano::store::memory::table const & table;
+	std::shared_mutex & mutex;
+	uint64_t const sequence;
+	nano::store::memory::table::container_t::const_iterator cursor;
+	std::pair<nano::store::memory::db_val, nano::store::memory::db_val> current;
+};
+}
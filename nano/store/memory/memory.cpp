@@ -0,0 +1,324 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/store/memory/iterator.hpp>
+#include <nano/store/memory/memory.hpp>
+#include <nano/store/memory/transaction_impl.hpp>
+#include <nano/store/version.hpp>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+
+namespace
+{
+int constexpr status_success = 0;
+int constexpr status_not_found = 1;
+
+nano::store::memory::table::key_t to_key (nano::store::memory::db_val const & val_a)
+{
+	auto data = static_cast<uint8_t const *> (val_a.data ());
+	return { data, data + val_a.size () };
+}
+}
+
+nano::store::memory::component::component (nano::store::write_queue_config const & write_queue_config_a) :
+	// clang-format off
+	nano::store::component{
+		block_store,
+		account_store,
+		pending_store,
+		online_weight_store,
+		pruned_store,
+		peer_store,
+		confirmation_height_store,
+		final_vote_store,
+		version_store,
+		rep_weight_store,
+		false, // write_queue use_noops
+		write_queue_config_a
+	},
+	// clang-format on
+	block_store{ *this },
+	account_store{ *this },
+	pending_store{ *this },
+	online_weight_store{ *this },
+	pruned_store{ *this },
+	peer_store{ *this },
+	confirmation_height_store{ *this },
+	final_vote_store{ *this },
+	version_store{ *this },
+	rep_weight_store{ *this }
+{
+	// All tables are created upfront so the table map itself is never modified concurrently
+	for (auto table : all_tables ())
+	{
+		tables_m.emplace (table, nano::store::memory::table{});
+	}
+	version.put (tx_begin_write (), version_current); // It is always fresh, someone needs to tell it its version.
+}
+
+nano::store::write_transaction nano::store::memory::component::tx_begin_write (std::vector<nano::tables> const &, std::vector<nano::tables> const &)
+{
+	return store::write_transaction{ std::make_unique<nano::store::memory::write_transaction_impl> (*this) };
+}
+
+nano::store::read_transaction nano::store::memory::component::tx_begin_read () const
+{
+	return store::read_transaction{ std::make_unique<nano::store::memory::read_transaction_impl> (*this) };
+}
+
+std::string nano::store::memory::component::vendor_get () const
+{
+	return "Memory (not persisted)";
+}
+
+uint64_t nano::store::memory::component::sequence (store::transaction const & transaction_a) const
+{
+	debug_assert (transaction_a.store_id () == store_id);
+	return *static_cast<uint64_t const *> (transaction_a.get_handle ());
+}
+
+uint64_t nano::store::memory::component::snapshot_acquire () const
+{
+	nano::lock_guard<nano::mutex> guard{ snapshots_mutex };
+	snapshots.insert (committed);
+	return committed;
+}
+
+void nano::store::memory::component::snapshot_release (uint64_t sequence_a) const
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ snapshots_mutex };
+		auto existing = snapshots.find (sequence_a);
+		debug_assert (existing != snapshots.end ());
+		snapshots.erase (existing);
+		// Versions retained for this snapshot can only be reclaimed when it was the oldest one
+		if (oldest_snapshot () <= sequence_a)
+		{
+			return;
+		}
+	}
+	if (!deferred_pending)
+	{
+		return;
+	}
+	// Readers and the writer are not held up by a release, a missed prune is picked up by the next release or commit
+	std::unique_lock lock{ mutex, std::try_to_lock };
+	if (!lock.owns_lock ())
+	{
+		return;
+	}
+	uint64_t oldest;
+	{
+		nano::lock_guard<nano::mutex> guard{ snapshots_mutex };
+		oldest = oldest_snapshot ();
+	}
+	prune_deferred (oldest);
+}
+
+void nano::store::memory::component::prune_deferred (uint64_t oldest_a) const
+{
+	if (oldest_a > pruned_oldest)
+	{
+		pruned_oldest = oldest_a;
+		for (auto & [table, contents] : tables_m)
+		{
+			contents.prune_deferred (oldest_a);
+		}
+	}
+	deferred_pending = std::any_of (tables_m.begin (), tables_m.end (), [] (auto const & item) { return item.second.deferred_size () > 0; });
+}
+
+uint64_t nano::store::memory::component::oldest_snapshot () const
+{
+	return snapshots.empty () ? committed : std::min (*snapshots.begin (), committed);
+}
+
+uint64_t nano::store::memory::component::write_begin ()
+{
+	write_mutex.lock ();
+	debug_assert (written.empty ());
+	nano::lock_guard<nano::mutex> guard{ snapshots_mutex };
+	return committed + 1;
+}
+
+void nano::store::memory::component::write_commit (uint64_t sequence_a)
+{
+	{
+		std::unique_lock lock{ mutex };
+		uint64_t oldest;
+		{
+			nano::lock_guard<nano::mutex> guard{ snapshots_mutex };
+			debug_assert (sequence_a == committed + 1);
+			committed = sequence_a;
+			oldest = oldest_snapshot ();
+		}
+		for (auto const & [table, entry] : written)
+		{
+			tables_m.at (table).prune (entry, oldest);
+		}
+		written.clear ();
+		prune_deferred (oldest);
+	}
+	write_mutex.unlock ();
+}
+
+bool nano::store::memory::component::exists (store::transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a) const
+{
+	std::shared_lock lock{ mutex };
+	return tables_m.at (table_a).get (to_key (key_a), sequence (transaction_a)) != nullptr;
+}
+
+int nano::store::memory::component::get (store::transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a, nano::store::memory::db_val & value_a) const
+{
+	std::shared_lock lock{ mutex };
+	auto const & value = tables_m.at (table_a).get (to_key (key_a), sequence (transaction_a));
+	if (value == nullptr)
+	{
+		return status_not_found;
+	}
+	// Values are immutable once written, sharing them avoids a copy
+	value_a.buffer = value;
+	value_a.convert_buffer_to_value ();
+	return status_success;
+}
+
+int nano::store::memory::component::put (store::write_transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a, nano::store::memory::db_val const & value_a)
+{
+	auto data = static_cast<uint8_t const *> (value_a.data ());
+	write (transaction_a, table_a, key_a, std::make_shared<std::vector<uint8_t>> (data, data + value_a.size ()));
+	return status_success;
+}
+
+int nano::store::memory::component::del (store::write_transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a)
+{
+	if (!exists (transaction_a, table_a, key_a))
+	{
+		return status_not_found;
+	}
+	write (transaction_a, table_a, key_a, nullptr);
+	return status_success;
+}
+
+void nano::store::memory::component::write (store::write_transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a, nano::store::memory::table::value_t value_a)
+{
+	std::unique_lock lock{ mutex };
+	if (auto entry = tables_m.at (table_a).write (to_key (key_a), std::move (value_a), sequence (transaction_a)))
+	{
+		written.emplace_back (table_a, *entry);
+	}
+}
+
+bool nano::store::memory::component::not_found (int status) const
+{
+	return status == status_not_found;
+}
+
+bool nano::store::memory::component::success (int status) const
+{
+	return status == status_success;
+}
+
+int nano::store::memory::component::status_code_not_found () const
+{
+	return status_not_found;
+}
+
+uint64_t nano::store::memory::component::count (store::transaction const & transaction_a, tables table_a) const
+{
+	// Versions visible to this transaction have to be counted, only use outside of hot paths
+	auto sequence_l = sequence (transaction_a);
+	std::shared_lock lock{ mutex };
+	auto const & entries = tables_m.at (table_a).entries;
+	return std::count_if (entries.begin (), entries.end (), [sequence_l] (auto const & entry) {
+		return nano::store::memory::table::visible (entry.second, sequence_l) != nullptr;
+	});
+}
+
+int nano::store::memory::component::drop (store::write_transaction const & transaction_a, tables table_a)
+{
+	std::vector<nano::store::memory::table::key_t> keys;
+	{
+		auto sequence_l = sequence (transaction_a);
+		std::shared_lock lock{ mutex };
+		for (auto const & [key, versions] : tables_m.at (table_a).entries)
+		{
+			if (nano::store::memory::table::visible (versions, sequence_l) != nullptr)
+			{
+				keys.push_back (key);
+			}
+		}
+	}
+	for (auto & key : keys)
+	{
+		write (transaction_a, table_a, nano::store::memory::db_val{ key.size (), key.data () }, nullptr);
+	}
+	return status_success;
+}
+
+std::vector<nano::tables> nano::store::memory::component::all_tables () const
+{
+	return std::vector<nano::tables>{ tables::accounts, tables::blocks, tables::confirmation_height, tables::final_votes, tables::meta, tables::online_weight, tables::peers, tables::pending, tables::pruned, tables::rep_weights, tables::vote };
+}
+
+bool nano::store::memory::component::copy_db (std::filesystem::path const & destination_path)
+{
+	// Not available for the in-memory store
+	return false;
+}
+
+void nano::store::memory::component::rebuild_db (store::write_transaction const & transaction_a)
+{
+	// Not applicable to the in-memory store
+}
+
+bool nano::store::memory::component::init_error () const
+{
+	return false;
+}
+
+void nano::store::memory::component::serialize_memory_stats (boost::property_tree::ptree & json)
+{
+	size_t entries = 0;
+	size_t versions = 0;
+	size_t deferred = 0;
+	{
+		std::shared_lock lock{ mutex };
+		for (auto const & [table, contents] : tables_m)
+		{
+			entries += contents.entries.size ();
+			versions += contents.versions ();
+			deferred += contents.deferred_size ();
+		}
+	}
+	json.put ("entries", entries);
+	json.put ("versions", versions);
+	json.put ("deferred", deferred);
+	{
+		nano::lock_guard<nano::mutex> guard{ snapshots_mutex };
+		json.put ("snapshots", snapshots.size ());
+	}
+}
+
+unsigned nano::store::memory::component::max_block_write_batch_num () const
+{
+	return std::numeric_limits<unsigned>::max ();
+}
+
+std::string nano::store::memory::component::error_string (int status) const
+{
+	switch (status)
+	{
+		case status_success:
+			return "success";
+		case status_not_found:
+			return "not found";
+	}
+	return std::to_string (status);
+}
+
+bool nano::store::memory::component::using_memory_store_in_tests ()
+{
+	auto use_memory_store_str = std::getenv ("TEST_USE_MEMORY_STORE");
+	return use_memory_store_str && (boost::lexical_cast<int> (use_memory_store_str) == 1);
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <nano/lib/id_dispenser.hpp>
+#include <nano/lib/locks.hpp>
+#include <nano/lib/numbers.hpp>
+#include <nano/secure/common.hpp>
+#include <nano/store/memory/account.hpp>
+#include <nano/store/memory/block.hpp>
+#include <nano/store/memory/confirmation_height.hpp>
+#include <nano/store/memory/db_val.hpp>
+#include <nano/store/memory/final_vote.hpp>
+#include <nano/store/memory/iterator.hpp>
+#include <nano/store/memory/online_weight.hpp>
+#include <nano/store/memory/peer.hpp>
+#include <nano/store/memory/pending.hpp>
+#include <nano/store/memory/pruned.hpp>
+#include <nano/store/memory/rep_weight.hpp>
+#include <nano/store/memory/table.hpp>
+#include <nano/store/memory/transaction_impl.hpp>
+#include <nano/store/memory/version.hpp>
+
+#include <atomic>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace nano::store::memory
+{
+/**
+ * In-memory implementation of the block store, nothing is persisted.
+ * Intended for benchmarking ledger logic independently of the database and for ephemeral nodes.
+ * Tables are sorted multi-version containers: there is a single writer at a time and
+ * read transactions observe a consistent snapshot of the last commit made before they started.
+ */
+class component : public nano::store::component
+{
+private:
+	nano::store::memory::account account_store;
+	nano::store::memory::block block_store;
+	nano::store::memory::confirmation_height confirmation_height_store;
+	nano::store::memory::final_vote final_vote_store;
+	nano::store::memory::online_weight online_weight_store;
+	nano::store::memory::peer peer_store;
+	nano::store::memory::pending pending_store;
+	nano::store::memory::pruned pruned_store;
+	nano::store::memory::version version_store;
+	nano::store::memory::rep_weight rep_weight_store;
+
+public:
+	friend class nano::store::memory::account;
+	friend class nano::store::memory::block;
+	friend class nano::store::memory::confirmation_height;
+	friend class nano::store::memory::final_vote;
+	friend class nano::store::memory::online_weight;
+	friend class nano::store::memory::peer;
+	friend class nano::store::memory::pending;
+	friend class nano::store::memory::pruned;
+	friend class nano::store::memory::version;
+	friend class nano::store::memory::rep_weight;
+	friend class nano::store::memory::read_transaction_impl;
+	friend class nano::store::memory::write_transaction_impl;
+
+	explicit component (nano::store::write_queue_config const & = nano::store::write_queue_config{});
+
+	store::write_transaction tx_begin_write (std::vector<nano::tables> const & tables_requiring_lock = {}, std::vector<nano::tables> const & tables_no_lock = {}) override;
+	store::read_transaction tx_begin_read () const override;
+
+	std::string vendor_get () const override;
+
+	uint64_t count (store::transaction const & transaction_a, tables table_a) const override;
+
+	bool exists (store::transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a) const;
+	int get (store::transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a, nano::store::memory::db_val & value_a) const;
+	int put (store::write_transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a, nano::store::memory::db_val const & value_a);
+	int del (store::write_transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key_a);
+
+	void serialize_memory_stats (boost::property_tree::ptree &) override;
+
+	bool copy_db (std::filesystem::path const & destination) override;
+	void rebuild_db (store::write_transaction const & transaction_a) override;
+
+	unsigned max_block_write_batch_num () const override;
+
+	template <typename Key, typename Value>
+	store::iterator<Key, Value> make_iterator (store::transaction const & transaction_a, tables table_a, bool const direction_asc = true) const
+	{
+		return store::iterator<Key, Value> (std::make_unique<nano::store::memory::iterator<Key, Value>> (tables_m.at (table_a), mutex, transaction_a, sequence (transaction_a), nullptr, direction_asc));
+	}
+
+	template <typename Key, typename Value>
+	store::iterator<Key, Value> make_iterator (store::transaction const & transaction_a, tables table_a, nano::store::memory::db_val const & key) const
+	{
+		return store::iterator<Key, Value> (std::make_unique<nano::store::memory::iterator<Key, Value>> (tables_m.at (table_a), mutex, transaction_a, sequence (transaction_a), &key, true));
+	}
+
+	bool init_error () const override;
+
+	std::string error_string (int status) const override;
+
+	/** To use the in-memory store in tests make sure the environment variable TEST_USE_MEMORY_STORE=1 is set */
+	static bool using_memory_store_in_tests ();
+
+	nano::id_t const store_id{ nano::next_id () };
+
+private:
+	bool not_found (int status) const override;
+	bool success (int status) const override;
+	void release_assert_success (int const status) const
+	{
+		if (!success (status))
+		{
+			release_assert (false, error_string (status));
+		}
+	}
+	int status_code_not_found () const override;
+	int drop (store::write_transaction const &, tables) override;
+
+	/** Sequence a transaction reads at, for the writer this includes its own uncommitted writes */
+	uint64_t sequence (store::transaction const &) const;
+	void write (store::write_transaction const &, tables, nano::store::memory::db_val const & key, nano::store::memory::table::value_t value);
+
+	uint64_t snapshot_acquire () const;
+	void snapshot_release (uint64_t sequence) const;
+	/** Oldest sequence any snapshot may read at, must hold snapshots_mutex */
+	uint64_t oldest_snapshot () const;
+	/** Reclaims deferred versions no longer visible once the oldest snapshot advanced, must hold mutex exclusively */
+	void prune_deferred (uint64_t oldest) const;
+	uint64_t write_begin ();
+	void write_commit (uint64_t sequence);
+
+	std::vector<nano::tables> all_tables () const;
+
+private:
+	// Mutable so versions deferred for a snapshot can be pruned when a read transaction releases it
+	mutable std::unordered_map<nano::tables, nano::store::memory::table> tables_m;
+	// Guards the table containers, exclusive access is only needed to add or remove entries
+	mutable std::shared_mutex mutex;
+	// Oldest snapshot deferred versions were last pruned at, guarded by exclusive mutex
+	mutable uint64_t pruned_oldest{ 0 };
+	// Lets snapshot releases skip the exclusive lock while no table has deferred versions
+	mutable std::atomic<bool> deferred_pending{ false };
+	// Single writer, held from write_begin until write_commit
+	nano::mutex write_mutex;
+	// Entries written by the current writer, pruned of superseded versions on commit
+	std::vector<std::pair<nano::tables, nano::store::memory::table::container_t::iterator>> written;
+
+	mutable nano::mutex snapshots_mutex;
+	// Sequences of active read transactions, versions they can observe are retained
+	mutable std::multiset<uint64_t> snapshots;
+	uint64_t committed{ 0 };
+};
+} // namespace nano::store::memory
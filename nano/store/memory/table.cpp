@@ -0,0 +1,99 @@
+#include <nano/lib/utility.hpp>
+#include <nano/store/memory/table.hpp>
+
+#include <algorithm>
+
+auto nano::store::memory::table::visible (std::vector<version> const & versions, uint64_t sequence) -> value_t const &
+{
+	static value_t const absent;
+	auto existing = std::find_if (versions.rbegin (), versions.rend (), [sequence] (auto const & version) {
+		return version.sequence <= sequence;
+	});
+	return existing != versions.rend () ? existing->value : absent;
+}
+
+auto nano::store::memory::table::get (key_t const & key, uint64_t sequence) const -> value_t const &
+{
+	static value_t const absent;
+	auto existing = entries.find (key);
+	return existing != entries.end () ? visible (existing->second, sequence) : absent;
+}
+
+auto nano::store::memory::table::write (key_t const & key, value_t value, uint64_t sequence) -> std::optional<container_t::iterator>
+{
+	auto [existing, inserted] = entries.try_emplace (key);
+	auto & versions = existing->second;
+	if (!versions.empty () && versions.back ().sequence == sequence)
+	{
+		// Overwriting a value written earlier by the same transaction
+		versions.back ().value = std::move (value);
+		return std::nullopt;
+	}
+	versions.push_back ({ sequence, std::move (value) });
+	return existing;
+}
+
+void nano::store::memory::table::prune (container_t::iterator existing, uint64_t oldest)
+{
+	auto key = existing->first;
+	if (prune_entry (existing, oldest))
+	{
+		deferred.insert (std::move (key));
+	}
+	else
+	{
+		deferred.erase (key);
+	}
+}
+
+void nano::store::memory::table::prune_deferred (uint64_t oldest)
+{
+	for (auto i = deferred.begin (), n = deferred.end (); i != n;)
+	{
+		auto existing = entries.find (*i);
+		debug_assert (existing != entries.end ());
+		if (existing == entries.end () || !prune_entry (existing, oldest))
+		{
+			i = deferred.erase (i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+}
+
+bool nano::store::memory::table::prune_entry (container_t::iterator existing, uint64_t oldest)
+{
+	auto & versions = existing->second;
+	// Keep the newest version visible to the oldest snapshot and everything written after it
+	auto keep = std::find_if (versions.rbegin (), versions.rend (), [oldest] (auto const & version) {
+		return version.sequence <= oldest;
+	});
+	if (keep != versions.rend ())
+	{
+		versions.erase (versions.begin (), std::prev (keep.base ()));
+	}
+	// A deletion observed by every snapshot leaves nothing to keep
+	if (versions.size () == 1 && versions.front ().value == nullptr && versions.front ().sequence <= oldest)
+	{
+		entries.erase (existing);
+		return false;
+	}
+	return versions.size () > 1 || versions.front ().value == nullptr;
+}
+
+size_t nano::store::memory::table::deferred_size () const
+{
+	return deferred.size ();
+}
+
+size_t nano::store::memory::table::versions () const
+{
+	size_t result = 0;
+	for (auto const & [key, versions] : entries)
+	{
+		result += versions.size ();
+	}
+	return result;
+}
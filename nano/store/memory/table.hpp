@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace nano::store::memory
+{
+/**
+ * Sorted, multi-versioned key/value table.
+ * Every key keeps the values written to it ordered by the commit sequence that wrote them, a null value marks a deletion.
+ * A transaction reading at sequence N observes the newest version written at or before N.
+ */
+class table
+{
+public:
+	using key_t = std::vector<uint8_t>;
+	using value_t = std::shared_ptr<std::vector<uint8_t>>;
+
+	class version
+	{
+	public:
+		uint64_t sequence;
+		value_t value;
+	};
+
+	using container_t = std::map<key_t, std::vector<version>>;
+
+public:
+	/** Returns the value visible at `sequence` or nullptr if the key is absent or deleted */
+	static value_t const & visible (std::vector<version> const &, uint64_t sequence);
+
+	value_t const & get (key_t const &, uint64_t sequence) const;
+
+	/**
+	 * Records a new value (nullptr to delete) written at `sequence`
+	 * Returns the entry when this is the first write to the key at `sequence`, so it can be pruned once committed
+	 */
+	std::optional<container_t::iterator> write (key_t const &, value_t, uint64_t sequence);
+
+	/**
+	 * Removes versions that are superseded for every snapshot at or after `oldest`
+	 * Entries still holding versions a live snapshot may observe are deferred until `prune_deferred`
+	 */
+	void prune (container_t::iterator, uint64_t oldest);
+
+	/** Prunes entries deferred by earlier calls to `prune`, called once the oldest live snapshot advances */
+	void prune_deferred (uint64_t oldest);
+
+	size_t deferred_size () const;
+
+	size_t versions () const;
+
+public:
+	container_t entries;
+
+private:
+	/** Returns true if the entry still holds versions that can be reclaimed later */
+	bool prune_entry (container_t::iterator, uint64_t oldest);
+
+	std::set<key_t> deferred;
+};
+}
@@ -0,0 +1,74 @@
+#include <nano/store/memory/memory.hpp>
+#include <nano/store/memory/transaction_impl.hpp>
+
+nano::store::memory::read_transaction_impl::read_transaction_impl (nano::store::memory::component const & store_a) :
+	store::read_transaction_impl (store_a.store_id),
+	store{ store_a }
+{
+	renew ();
+}
+
+nano::store::memory::read_transaction_impl::~read_transaction_impl ()
+{
+	reset ();
+}
+
+void nano::store::memory::read_transaction_impl::reset ()
+{
+	if (active)
+	{
+		store.snapshot_release (sequence);
+		active = false;
+	}
+}
+
+void nano::store::memory::read_transaction_impl::renew ()
+{
+	debug_assert (!active);
+	sequence = store.snapshot_acquire ();
+	active = true;
+}
+
+void * nano::store::memory::read_transaction_impl::get_handle () const
+{
+	return const_cast<uint64_t *> (&sequence);
+}
+
+nano::store::memory::write_transaction_impl::write_transaction_impl (nano::store::memory::component & store_a) :
+	store::write_transaction_impl (store_a.store_id),
+	store{ store_a }
+{
+	renew ();
+}
+
+nano::store::memory::write_transaction_impl::~write_transaction_impl ()
+{
+	commit ();
+}
+
+void nano::store::memory::write_transaction_impl::commit ()
+{
+	if (active)
+	{
+		store.write_commit (sequence);
+		active = false;
+	}
+}
+
+void nano::store::memory::write_transaction_impl::renew ()
+{
+	debug_assert (!active);
+	sequence = store.write_begin ();
+	active = true;
+}
+
+void * nano::store::memory::write_transaction_impl::get_handle () const
+{
+	return const_cast<uint64_t *> (&sequence);
+}
+
+bool nano::store::memory::write_transaction_impl::contains (nano::tables table_a) const
+{
+	// There is a single writer for all tables
+	return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <nano/store/component.hpp>
+#include <nano/store/transaction.hpp>
+
+namespace nano::store::memory
+{
+class component;
+}
+
+namespace nano::store::memory
+{
+/**
+ * Snapshot of the last committed sequence, registered with the store for as long as the transaction is active
+ */
+class read_transaction_impl final : public store::read_transaction_impl
+{
+public:
+	explicit read_transaction_impl (nano::store::memory::component const &);
+	~read_transaction_impl ();
+	void reset () override;
+	void renew () override;
+	void * get_handle () const override;
+
+private:
+	nano::store::memory::component const & store;
+	uint64_t sequence{ 0 };
+	bool active{ false };
+};
+
+/**
+ * Exclusive writer, values written are tagged with the next sequence and become visible to readers on commit
+ */
+class write_transaction_impl final : public store::write_transaction_impl
+{
+public:
+	explicit write_transaction_impl (nano::store::memory::component &);
+	~write_transaction_impl ();
+	void commit () override;
+	void renew () override;
+	void * get_handle () const override;
+	bool contains (nano::tables table_a) const override;
+
+private:
+	nano::store::memory::component & store;
+	uint64_t sequence{ 0 };
+	bool active{ false };
+};
+}
@@ -165,7 +165,8 @@ void nano::store::rocksdb::block::block_raw_get (store::transaction const & tran
 
 size_t nano::store::rocksdb::block::block_successor_offset (store::transaction const & transaction_a, size_t entry_size_a, nano::block_type type_a) const
 {
-	return entry_size_a - nano::block_sideband::size (type_a);
+	// The successor is the first sideband field, directly after the type byte and the block body
+	return sizeof (nano::block_type) + nano::block::size (type_a);
 }
 
 nano::block_type nano::store::rocksdb::block::block_type_from_raw (void * data_a)
@@ -35,7 +35,7 @@ private:
 };
 }
 
-nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesystem::path const & path_a, nano::ledger_constants & constants, nano::rocksdb_config const & rocksdb_config_a, bool open_read_only_a, bool force_use_write_queue) :
+nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesystem::path const & path_a, nano::ledger_constants & constants, nano::rocksdb_config const & rocksdb_config_a, bool open_read_only_a, bool force_use_write_queue, nano::store::write_queue_config const & write_queue_config_a) :
 	// clang-format off
 	nano::store::component{
 		block_store,
@@ -48,7 +48,8 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 		final_vote_store,
 		version_store,
 		rep_weight_store,
-		!force_use_write_queue // write_queue use_noops
+		!force_use_write_queue, // write_queue use_noops
+		write_queue_config_a
 	},
 	// clang-format on
 	block_store{ *this },
@@ -64,7 +65,7 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 	logger{ logger_a },
 	constants{ constants },
 	rocksdb_config{ rocksdb_config_a },
-	max_block_write_batch_num_m{ nano::narrow_cast<unsigned> ((rocksdb_config_a.write_cache * 1024 * 1024) / (2 * (sizeof (nano::block_type) + nano::state_block::size + nano::block_sideband::size (nano::block_type::state)))) },
+	max_block_write_batch_num_m{ nano::narrow_cast<unsigned> ((rocksdb_config_a.write_cache * 1024 * 1024) / (2 * (sizeof (nano::block_type) + nano::state_block::size + nano::block_sideband::max_size (nano::block_type::state)))) },
 	cf_name_table_map{ create_cf_name_table_map () }
 {
 	boost::system::error_code error_mkdir, error_chmod;
@@ -248,6 +249,9 @@ bool nano::store::rocksdb::component::do_upgrades (store::write_transaction & tr
 			upgrade_v23_to_v24 (transaction);
 			[[fallthrough]];
 		case 24:
+			upgrade_v24_to_v25 (transaction);
+			[[fallthrough]];
+		case 25:
 			break;
 		default:
 			logger.critical (nano::log::type::rocksdb, "The version of the ledger ({}) is too high for this node", version_l);
@@ -392,6 +396,71 @@ void nano::store::rocksdb::component::upgrade_v23_to_v24 (store::write_transacti
 	logger.info (nano::log::type::rocksdb, "Upgrading database from v23 to v24 completed");
 }
 
+// Rewrite all block entries with the compact sideband format
+void nano::store::rocksdb::component::upgrade_v24_to_v25 (store::write_transaction & transaction)
+{
+	logger.info (nano::log::type::rocksdb, "Upgrading database from v24 to v25...");
+
+	// Entries are read in batches with the write transaction so no older snapshot of the blocks table has to be retained
+	size_t const batch_size = 100000;
+
+	std::vector<std::pair<nano::block_hash, nano::store::block_w_sideband_v24>> batch;
+	std::optional<nano::block_hash> last;
+	uint64_t processed = 0;
+	uint64_t size_before = 0;
+	uint64_t size_after = 0;
+	do
+	{
+		batch.clear ();
+		{
+			// Manually create v24 compatible iterator to read blocks
+			auto it = last ? make_iterator<nano::block_hash, nano::store::block_w_sideband_v24> (transaction, tables::blocks, nano::store::rocksdb::db_val{ *last }) : make_iterator<nano::block_hash, nano::store::block_w_sideband_v24> (transaction, tables::blocks);
+			auto const end = store::iterator<nano::block_hash, nano::store::block_w_sideband_v24> (nullptr);
+			if (last && it != end && it->first == *last)
+			{
+				++it;
+			}
+			for (; it != end && batch.size () < batch_size; ++it)
+			{
+				batch.emplace_back (it->first, it->second);
+			}
+		}
+		for (auto const & [hash, entry] : batch)
+		{
+			auto const type = entry.block->type ();
+			auto const size = sizeof (nano::block_type) + nano::block::size (type);
+			if (entry.compact)
+			{
+				// Batches committed before an interrupted upgrade are already converted
+				size_before += size + entry.sideband.size (type);
+				size_after += size + entry.sideband.size (type);
+				continue;
+			}
+			std::vector<uint8_t> vector;
+			{
+				nano::vectorstream stream (vector);
+				nano::serialize_block (stream, *entry.block);
+				entry.sideband.serialize (stream, type);
+			}
+			block_store.raw_put (transaction, vector, hash);
+			size_before += size + nano::block_sideband::size_v24 (type);
+			size_after += vector.size ();
+		}
+		if (!batch.empty ())
+		{
+			last = batch.back ().first;
+			processed += batch.size ();
+			logger.info (nano::log::type::rocksdb, "Processed {} blocks", processed);
+			transaction.refresh (); // Refresh to prevent excessive memory usage
+		}
+	} while (batch.size () == batch_size);
+
+	logger.info (nano::log::type::rocksdb, "Done processing {} blocks, entries reduced from {} to {} bytes", processed, size_before, size_after);
+	version.put (transaction, 25);
+
+	logger.info (nano::log::type::rocksdb, "Upgrading database from v24 to v25 completed");
+}
+
 void nano::store::rocksdb::component::generate_tombstone_map ()
 {
 	tombstone_map.emplace (std::piecewise_construct, std::forward_as_tuple (nano::tables::blocks), std::forward_as_tuple (0, 25000));
@@ -443,6 +512,20 @@ nano::store::write_transaction nano::store::rocksdb::component::tx_begin_write (
 	return store::write_transaction{ std::move (txn) };
 }
 
+nano::store::write_transaction nano::store::rocksdb::component::tx_begin_write_bulk (std::vector<nano::tables> const & tables_a)
+{
+	release_assert (db != nullptr);
+	return store::write_transaction{ std::make_unique<nano::store::rocksdb::write_transaction_impl> (transaction_db, std::vector<nano::tables>{}, tables_a, write_lock_mutexes, /* bulk */ true) };
+}
+
+void nano::store::rocksdb::component::flush ()
+{
+	for (auto table : all_tables ())
+	{
+		flush_table (table);
+	}
+}
+
 nano::store::read_transaction nano::store::rocksdb::component::tx_begin_read () const
 {
 	return store::read_transaction{ std::make_unique<nano::store::rocksdb::read_transaction_impl> (db.get ()) };
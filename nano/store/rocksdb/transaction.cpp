@@ -32,16 +32,17 @@ void * nano::store::rocksdb::read_transaction_impl::get_handle () const
 	return (void *)&options;
 }
 
-nano::store::rocksdb::write_transaction_impl::write_transaction_impl (::rocksdb::TransactionDB * db_a, std::vector<nano::tables> const & tables_requiring_locks_a, std::vector<nano::tables> const & tables_no_locks_a, std::unordered_map<nano::tables, nano::mutex> & mutexes_a) :
+nano::store::rocksdb::write_transaction_impl::write_transaction_impl (::rocksdb::TransactionDB * db_a, std::vector<nano::tables> const & tables_requiring_locks_a, std::vector<nano::tables> const & tables_no_locks_a, std::unordered_map<nano::tables, nano::mutex> & mutexes_a, bool bulk_a) :
 	db (db_a),
 	tables_requiring_locks (tables_requiring_locks_a),
 	tables_no_locks (tables_no_locks_a),
 	mutexes (mutexes_a)
 {
 	lock ();
-	::rocksdb::TransactionOptions txn_options;
-	txn_options.set_snapshot = true;
-	txn = db->BeginTransaction (::rocksdb::WriteOptions (), txn_options);
+	txn_options.set_snapshot = !bulk_a;
+	txn_options.skip_concurrency_control = bulk_a;
+	write_options.disableWAL = bulk_a;
+	txn = db->BeginTransaction (write_options, txn_options);
 }
 
 nano::store::rocksdb::write_transaction_impl::~write_transaction_impl ()
@@ -63,9 +64,7 @@ void nano::store::rocksdb::write_transaction_impl::commit ()
 
 void nano::store::rocksdb::write_transaction_impl::renew ()
 {
-	::rocksdb::TransactionOptions txn_options;
-	txn_options.set_snapshot = true;
-	db->BeginTransaction (::rocksdb::WriteOptions (), txn_options, txn);
+	db->BeginTransaction (write_options, txn_options, txn);
 	active = true;
 }
 
@@ -26,7 +26,8 @@ private:
 class write_transaction_impl final : public store::write_transaction_impl
 {
 public:
-	write_transaction_impl (::rocksdb::TransactionDB * db_a, std::vector<nano::tables> const & tables_requiring_locks_a, std::vector<nano::tables> const & tables_no_locks_a, std::unordered_map<nano::tables, nano::mutex> & mutexes_a);
+	/** Bulk transactions skip row locking, snapshot validation and the write-ahead log, writes are only durable once memtables are flushed */
+	write_transaction_impl (::rocksdb::TransactionDB * db_a, std::vector<nano::tables> const & tables_requiring_locks_a, std::vector<nano::tables> const & tables_no_locks_a, std::unordered_map<nano::tables, nano::mutex> & mutexes_a, bool bulk_a = false);
 	~write_transaction_impl ();
 	void commit () override;
 	void renew () override;
@@ -39,6 +40,8 @@ private:
 	std::vector<nano::tables> tables_requiring_locks;
 	std::vector<nano::tables> tables_no_locks;
 	std::unordered_map<nano::tables, nano::mutex> & mutexes;
+	::rocksdb::WriteOptions write_options;
+	::rocksdb::TransactionOptions txn_options;
 	bool active{ true };
 
 	void lock ();
@@ -1,4 +1,6 @@
 #include <nano/lib/config.hpp>
+#include <nano/lib/enum_util.hpp>
+#include <nano/lib/tomlconfig.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/store/write_queue.hpp>
 
@@ -36,6 +38,11 @@ bool nano::store::write_guard::is_owned () const
 	return owns;
 }
 
+bool nano::store::write_guard::should_yield () const
+{
+	return owns && queue.should_yield (type);
+}
+
 void nano::store::write_guard::release ()
 {
 	release_assert (owns);
@@ -54,8 +61,9 @@ void nano::store::write_guard::renew ()
  * write_queue
  */
 
-nano::store::write_queue::write_queue (bool use_noops_a) :
-	use_noops{ use_noops_a }
+nano::store::write_queue::write_queue (bool use_noops_a, write_queue_config const & config_a) :
+	use_noops{ use_noops_a },
+	config{ config_a }
 {
 }
 
@@ -68,15 +76,16 @@ bool nano::store::write_queue::contains (writer writer) const
 {
 	debug_assert (!use_noops);
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	return std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
+	return (current && current->type == writer) || std::any_of (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item.type == writer; });
 }
 
 void nano::store::write_queue::pop ()
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
-	if (!queue.empty ())
+	if (current)
 	{
-		queue.pop_front ();
+		current.reset ();
+		promote ();
 	}
 	condition.notify_all ();
 }
@@ -91,16 +100,22 @@ void nano::store::write_queue::acquire (writer writer)
 	nano::unique_lock<nano::mutex> lock{ mutex };
 
 	// There should be no duplicates in the queue
-	debug_assert (std::none_of (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item == writer; }));
+	debug_assert (!(current && current->type == writer));
+	debug_assert (std::none_of (queue.cbegin (), queue.cend (), [writer] (auto const & item) { return item.type == writer; }));
 
-	// Add writer to the end of the queue if it's not already waiting
-	auto exists = std::find (queue.cbegin (), queue.cend (), writer) != queue.cend ();
-	if (!exists)
+	auto const enqueued = std::chrono::steady_clock::now ();
+	queue.push_back ({ writer, enqueued });
+	if (!current)
 	{
-		queue.push_back (writer);
+		promote ();
 	}
 
-	condition.wait (lock, [&] () { return queue.front () == writer; });
+	condition.wait (lock, [&] () { return current && current->type == writer; });
+
+	auto const waited = current_since - enqueued;
+	lock.unlock ();
+
+	acquired.notify (writer, waited);
 }
 
 void nano::store::write_queue::release (writer writer)
@@ -109,11 +124,141 @@ void nano::store::write_queue::release (writer writer)
 	{
 		return; // Pass immediately
 	}
+
+	std::chrono::steady_clock::duration held;
 	{
 		nano::lock_guard<nano::mutex> guard{ mutex };
-		release_assert (!queue.empty ());
-		release_assert (queue.front () == writer);
-		queue.pop_front ();
+		release_assert (current);
+		release_assert (current->type == writer);
+		held = std::chrono::steady_clock::now () - current_since;
+		current.reset ();
+		promote ();
 	}
 	condition.notify_all ();
-}
\ No newline at end of file
+
+	released.notify (writer, held);
+}
+
+bool nano::store::write_queue::should_yield (writer writer) const
+{
+	if (use_noops)
+	{
+		return false; // Nothing is waiting
+	}
+
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	debug_assert (current && current->type == writer);
+	auto const now = std::chrono::steady_clock::now ();
+	if (now - current_since < config.max_hold)
+	{
+		return false;
+	}
+	auto const priority = config.priority (writer);
+	return std::any_of (queue.cbegin (), queue.cend (), [&] (auto const & item) {
+		return effective_priority (item.type, item.enqueued, now) > priority;
+	});
+}
+
+void nano::store::write_queue::promote ()
+{
+	debug_assert (!current);
+
+	if (queue.empty ())
+	{
+		return;
+	}
+
+	// Strict comparison keeps the earliest arrival among equal priorities
+	auto const now = std::chrono::steady_clock::now ();
+	auto best = queue.begin ();
+	auto best_priority = effective_priority (best->type, best->enqueued, now);
+	for (auto it = std::next (queue.begin ()), end = queue.end (); it != end; ++it)
+	{
+		auto priority = effective_priority (it->type, it->enqueued, now);
+		if (priority > best_priority)
+		{
+			best = it;
+			best_priority = priority;
+		}
+	}
+
+	current = *best;
+	current_since = now;
+	queue.erase (best);
+}
+
+std::size_t nano::store::write_queue::effective_priority (writer writer, std::chrono::steady_clock::time_point enqueued, std::chrono::steady_clock::time_point now) const
+{
+	// Aging ensures low priority writers are eventually granted access under sustained load
+	auto const aging = config.aging_interval.count () > 0 ? static_cast<std::size_t> ((now - enqueued) / config.aging_interval) : 0;
+	return config.priority (writer) + aging;
+}
+
+/*
+ * write_queue_config
+ */
+
+std::size_t nano::store::write_queue_config::priority (writer writer) const
+{
+	switch (writer)
+	{
+		case writer::blockprocessor:
+			return priority_blockprocessor;
+		case writer::confirmation_height:
+			return priority_confirmation_height;
+		case writer::voting_final:
+			return priority_voting_final;
+		case writer::node:
+			return priority_node;
+		case writer::pruning:
+			return priority_pruning;
+		case writer::generic:
+		case writer::testing:
+			return priority_generic;
+	}
+	debug_assert (false);
+	return priority_generic;
+}
+
+nano::error nano::store::write_queue_config::serialize (nano::tomlconfig & toml) const
+{
+	toml.put ("priority_blockprocessor", priority_blockprocessor, "Relative priority of block processor database writes. Higher priority writers are granted access first.\ntype:uint64");
+	toml.put ("priority_confirmation_height", priority_confirmation_height, "Relative priority of cementing database writes.\ntype:uint64");
+	toml.put ("priority_voting_final", priority_voting_final, "Relative priority of final vote database writes.\ntype:uint64");
+	toml.put ("priority_node", priority_node, "Relative priority of node database writes, such as processing local blocks.\ntype:uint64");
+	toml.put ("priority_generic", priority_generic, "Relative priority of generic database writes, such as RPC and wallet actions.\ntype:uint64");
+	toml.put ("priority_pruning", priority_pruning, "Relative priority of ledger pruning database writes.\ntype:uint64");
+	toml.put ("max_hold", max_hold.count (), "Time after which a writer is asked to yield database access to a waiting higher priority writer.\ntype:milliseconds");
+	toml.put ("aging_interval", aging_interval.count (), "Waiting writers gain one priority level for each such period spent in the queue, so low priority writers are not starved. 0 disables aging.\ntype:milliseconds");
+
+	return toml.get_error ();
+}
+
+nano::error nano::store::write_queue_config::deserialize (nano::tomlconfig & toml)
+{
+	toml.get ("priority_blockprocessor", priority_blockprocessor);
+	toml.get ("priority_confirmation_height", priority_confirmation_height);
+	toml.get ("priority_voting_final", priority_voting_final);
+	toml.get ("priority_node", priority_node);
+	toml.get ("priority_generic", priority_generic);
+	toml.get ("priority_pruning", priority_pruning);
+
+	auto max_hold_l = max_hold.count ();
+	toml.get ("max_hold", max_hold_l);
+	max_hold = std::chrono::milliseconds{ max_hold_l };
+
+	auto aging_interval_l = aging_interval.count ();
+	toml.get ("aging_interval", aging_interval_l);
+	aging_interval = std::chrono::milliseconds{ aging_interval_l };
+
+	return toml.get_error ();
+}
+
+/*
+ *
+ */
+
+nano::stat::detail nano::to_stat_detail (nano::store::writer writer)
+{
+	return nano::enum_util::cast<nano::stat::detail> (writer);
+}
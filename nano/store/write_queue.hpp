@@ -1,10 +1,19 @@
 #pragma once
 
+#include <nano/lib/errors.hpp>
 #include <nano/lib/locks.hpp>
+#include <nano/lib/observer_set.hpp>
+#include <nano/lib/stats_enums.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
-#include <functional>
+#include <optional>
+
+namespace nano
+{
+class tomlconfig;
+}
 
 namespace nano::store
 {
@@ -22,6 +31,28 @@ enum class writer
 
 class write_queue;
 
+class write_queue_config final
+{
+public:
+	nano::error deserialize (nano::tomlconfig &);
+	nano::error serialize (nano::tomlconfig &) const;
+
+	std::size_t priority (writer) const;
+
+public:
+	/** Higher priority writers are granted access first, waiting writers gain one level for every `aging_interval` spent in the queue */
+	std::size_t priority_blockprocessor{ 8 };
+	std::size_t priority_confirmation_height{ 8 };
+	std::size_t priority_voting_final{ 8 };
+	std::size_t priority_node{ 4 };
+	std::size_t priority_generic{ 2 };
+	std::size_t priority_pruning{ 1 };
+	/** Writers are asked to yield after holding access for this long while a higher priority writer is waiting */
+	std::chrono::milliseconds max_hold{ 100 };
+	/** Should span many `max_hold` periods, otherwise aging quickly cancels out the priorities. Zero disables aging */
+	std::chrono::milliseconds aging_interval{ 1000 };
+};
+
 class write_guard final
 {
 public:
@@ -38,6 +69,9 @@ public:
 
 	bool is_owned () const;
 
+	/** Returns true if access was held longer than the configured hint while a higher priority writer is waiting */
+	bool should_yield () const;
+
 	writer const type;
 
 private:
@@ -48,13 +82,14 @@ private:
 /**
  * Allocates database write access in a fair maner rather than directly waiting for mutex aquisition
  * Users should wait() for access to database write transaction and hold the write_guard until complete
+ * Waiting writers are granted access by priority, ties are broken by arrival order
  */
 class write_queue final
 {
 	friend class write_guard;
 
 public:
-	explicit write_queue (bool use_noops);
+	explicit write_queue (bool use_noops, write_queue_config const & = {});
 
 	/** Blocks until we are at the head of the queue and blocks other waiters until write_guard goes out of scope */
 	[[nodiscard ("write_guard blocks other waiters")]] write_guard wait (writer writer);
@@ -65,17 +100,40 @@ public:
 	/** Doesn't actually pop anything until the returned write_guard is out of scope */
 	void pop ();
 
+public: // Events
+	/** Called after a writer is granted access, with the time it spent waiting */
+	nano::observer_set<writer, std::chrono::steady_clock::duration> acquired;
+	/** Called after a writer releases access, with the time it was held */
+	nano::observer_set<writer, std::chrono::steady_clock::duration> released;
+
 private:
 	void acquire (writer writer);
 	void release (writer writer);
+	bool should_yield (writer writer) const;
+
+	/** Grants access to the waiting writer with the highest effective priority, must hold the lock */
+	void promote ();
+	std::size_t effective_priority (writer, std::chrono::steady_clock::time_point enqueued, std::chrono::steady_clock::time_point now) const;
 
 private:
 	bool const use_noops;
+	write_queue_config const config;
 
-	std::deque<writer> queue;
+	struct entry
+	{
+		writer type;
+		std::chrono::steady_clock::time_point enqueued;
+	};
+
+	std::deque<entry> queue; // Waiting writers in arrival order
+	std::optional<entry> current; // Writer holding access
+	std::chrono::steady_clock::time_point current_since;
 	mutable nano::mutex mutex;
 	nano::condition_variable condition;
-
-	std::function<void ()> guard_finish_callback;
 };
 } // namespace nano::store
+
+namespace nano
+{
+nano::stat::detail to_stat_detail (nano::store::writer);
+}
@@ -3,9 +3,15 @@
 #include <nano/secure/common.hpp>
 #include <nano/secure/utility.hpp>
 #include <nano/store/component.hpp>
+#include <nano/store/memory/memory.hpp>
 #include <nano/test_common/make_store.hpp>
 
 std::unique_ptr<nano::store::component> nano::test::make_store ()
 {
 	return nano::make_store (nano::default_logger (), nano::unique_path (), nano::dev::constants);
 }
+
+std::unique_ptr<nano::store::component> nano::test::make_memory_store ()
+{
+	return std::make_unique<nano::store::memory::component> ();
+}
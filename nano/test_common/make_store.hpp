@@ -10,4 +10,6 @@ class component;
 namespace nano::test
 {
 std::unique_ptr<nano::store::component> make_store ();
+/** Creates a store that keeps everything in memory, regardless of the backend selected for tests */
+std::unique_ptr<nano::store::component> make_memory_store ();
 }